@@ -0,0 +1,217 @@
+#ifndef BLOCK_ENTROPY_CALCULATOR_HPP
+#define BLOCK_ENTROPY_CALCULATOR_HPP
+
+#include "market_data.hpp"
+#include "entropy_math.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Sliding block (n-gram) entropy over the action stream.
+// Keeps counts of every length-k action block for k = 1..max_order inside a
+// window of the last window_size actions, stored flat and indexed by the
+// block's base-3 code. Each new action adds one block per order and each
+// evicted action removes one, so an update is O(max_order) and the window is
+// never rescanned. Reports block entropies H_k and the entropy rate estimate
+// h_k = H_k - H_{k-1}, which separates BUY,SELL,BUY,SELL from a random mix.
+//
+// The window holds size-k+1 blocks of order k but size-k+2 of order k-1, so
+// subtracting the reported H_{k-1} would read low by a finite-window bias that
+// grows with k relative to the window. The rate instead takes H_{k-1} over the
+// same blocks as H_k (their k-1 prefixes), which makes it the empirical
+// conditional entropy and never negative.
+class BlockEntropyCalculator {
+public:
+    static constexpr size_t kMaxOrder = 6;
+    static constexpr size_t kStates = 3;
+
+    explicit BlockEntropyCalculator(size_t window_size = 500, size_t max_order = 4)
+        : window_size_(std::max<size_t>(window_size, 1))
+        , max_order_(std::min(std::max<size_t>(max_order, 1), kMaxOrder))
+        , ring_(window_size_)
+        , head_(0)
+        , size_(0)
+        , recent_code_(0)
+        , counts_{}
+        , count_log_sums_{}
+        , updates_since_resync_(0)
+        , log_table_(make_count_log2_table(window_size_))
+    {}
+
+    void add_action(TraderAction action) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        push_action(action);
+    }
+
+    void add_actions_batch(const std::vector<TraderAction>& actions) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& action : actions) {
+            push_action(action);
+        }
+    }
+
+    // Block entropy H_k in bits for 1 <= k <= max_order (0 for H_0 or out of range)
+    double get_block_entropy(size_t order) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block_entropy(order);
+    }
+
+    // Entropy rate estimate h_k = H_k - H_{k-1} in bits per action, with both
+    // terms over the same size-k+1 blocks. It is then non-negative in exact
+    // arithmetic, and the clamp only removes floating-point rounding.
+    double get_entropy_rate(size_t order) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (order == 0 || order > max_order_) return 0.0;
+        return std::max(0.0, block_entropy(order) - prefix_entropy(order));
+    }
+
+    // Entropy rate at the highest configured order
+    double get_entropy_rate() const {
+        return get_entropy_rate(max_order_);
+    }
+
+    // H_1 .. H_max_order, index 0 holds H_1
+    std::vector<double> get_block_entropies() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<double> entropies;
+        entropies.reserve(max_order_);
+        for (size_t k = 1; k <= max_order_; ++k) {
+            entropies.push_back(block_entropy(k));
+        }
+        return entropies;
+    }
+
+    // Window count of one block given oldest-first, e.g. {BUY, SELL}
+    uint32_t get_block_count(const std::vector<TraderAction>& block) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (block.empty() || block.size() > max_order_) return 0;
+
+        size_t code = 0;
+        for (const auto& action : block) {
+            code = code * kStates + static_cast<size_t>(action);
+        }
+        return counts_[kOrderOffsets[block.size()] + code];
+    }
+
+    size_t get_window_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    size_t get_max_order() const {
+        return max_order_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = 0;
+        size_ = 0;
+        recent_code_ = 0;
+        counts_.fill(0);
+        count_log_sums_.fill(0.0);
+        updates_since_resync_ = 0;
+    }
+
+private:
+    // 3^k for k = 0..kMaxOrder
+    static constexpr std::array<size_t, kMaxOrder + 1> kPowers{1, 3, 9, 27, 81, 243, 729};
+    // Start of order k's block counts in the flat array (order 0 unused)
+    static constexpr std::array<size_t, kMaxOrder + 2> kOrderOffsets{0, 0, 3, 12, 39, 120, 363, 1092};
+    // Incremental sums are rebuilt from the integer counts this often to bound drift
+    static constexpr size_t kResyncInterval = size_t{1} << 16;
+
+    void push_action(TraderAction action) {
+        if (size_ == window_size_) {
+            evict_oldest();
+        }
+
+        size_t symbol = static_cast<size_t>(action);
+        ring_[(head_ + size_) % window_size_] = static_cast<uint8_t>(symbol);
+        size_++;
+
+        // The block of order k ending at the new action is the low k digits
+        // of the rolling code over the last max_order actions
+        recent_code_ = (recent_code_ * kStates + symbol) % kPowers[max_order_];
+        size_t orders = std::min(size_, max_order_);
+        for (size_t k = 1; k <= orders; ++k) {
+            increment(k, recent_code_ % kPowers[k]);
+        }
+
+        if (++updates_since_resync_ >= kResyncInterval) {
+            resync_count_log_sums();
+        }
+    }
+
+    // Remove the blocks that start at the oldest action, then drop it
+    void evict_oldest() {
+        size_t orders = std::min(size_, max_order_);
+        size_t code = 0;
+        for (size_t k = 1; k <= orders; ++k) {
+            code = code * kStates + ring_[(head_ + k - 1) % window_size_];
+            decrement(k, code);
+        }
+
+        head_ = (head_ + 1) % window_size_;
+        size_--;
+    }
+
+    void increment(size_t order, size_t code) {
+        uint32_t& count = counts_[kOrderOffsets[order] + code];
+        count_log_sums_[order] += log_table_[count + 1] - log_table_[count];
+        count++;
+    }
+
+    void decrement(size_t order, size_t code) {
+        uint32_t& count = counts_[kOrderOffsets[order] + code];
+        count_log_sums_[order] += log_table_[count - 1] - log_table_[count];
+        count--;
+    }
+
+    void resync_count_log_sums() {
+        for (size_t k = 1; k <= max_order_; ++k) {
+            double sum = 0.0;
+            for (size_t i = kOrderOffsets[k]; i < kOrderOffsets[k + 1]; ++i) {
+                sum += log_table_[counts_[i]];
+            }
+            count_log_sums_[k] = sum;
+        }
+        updates_since_resync_ = 0;
+    }
+
+    size_t block_count_total(size_t order) const {
+        return size_ >= order ? size_ - order + 1 : 0;
+    }
+
+    double block_entropy(size_t order) const {
+        if (order == 0 || order > max_order_) return 0.0;
+        return entropy_from_count_sum(count_log_sums_[order], block_count_total(order));
+    }
+
+    // H_{k-1} over the k-1 prefixes of the order-k blocks: every order k-1
+    // block except the newest one, which no order-k block in the window starts
+    double prefix_entropy(size_t order) const {
+        if (order < 2 || size_ < order) return 0.0;
+        uint32_t newest = counts_[kOrderOffsets[order - 1] + recent_code_ % kPowers[order - 1]];
+        double count_log_sum = count_log_sums_[order - 1] - log_table_[newest] + log_table_[newest - 1];
+        return entropy_from_count_sum(count_log_sum, block_count_total(order));
+    }
+
+    // Configuration parameters
+    size_t window_size_;
+    size_t max_order_;
+
+    // Thread-safe state
+    mutable std::mutex mutex_;
+    std::vector<uint8_t> ring_;
+    size_t head_;
+    size_t size_;
+    size_t recent_code_;
+    std::array<uint32_t, kOrderOffsets[kMaxOrder + 1]> counts_;
+    std::array<double, kMaxOrder + 1> count_log_sums_;
+    size_t updates_since_resync_;
+    std::vector<double> log_table_;
+};
+
+#endif // BLOCK_ENTROPY_CALCULATOR_HPP
@@ -0,0 +1,310 @@
+#ifndef CHANGE_POINT_DETECTOR_HPP
+#define CHANGE_POINT_DETECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Online change-point detectors over the entropy series. Each detector is fed
+// one value per update and fills a RegimeShiftEvent when it decides the mean
+// has shifted, so consumers can react to regime changes without polling
+// thresholds. PageHinkleyDetector and CusumDetector keep O(1) state (a few
+// doubles) and are cheap enough to run per symbol inside the consumer;
+// BayesianChangePointDetector keeps O(MaxRunLength) state.
+//
+// Tuning: the tolerance (delta / slack) is about half the smallest shift in
+// bits worth reporting; the threshold (lambda / h) trades detection delay for
+// false alarms, which become rare once 2 * tolerance * threshold is several
+// times the variance of the entropy series.
+//
+// Common interface:
+//   bool update(double value, RegimeShiftEvent& event);  // true on a shift
+//   void reset();
+
+enum class RegimeShiftDirection : int8_t {
+    DOWN = -1,  // entropy fell: more directional conviction
+    UP = 1      // entropy rose: more disorder
+};
+
+struct RegimeShiftEvent {
+    uint64_t sequence;              // index of the update that triggered it
+    double entropy;                 // value that triggered it
+    double baseline;                // detector's estimate of the old regime mean
+    double statistic;               // test statistic at detection
+    RegimeShiftDirection direction;
+};
+
+// Two-sided Page-Hinkley test. Tracks the running mean of the current regime
+// and the cumulative deviation from it (less a tolerance delta); a shift is
+// reported when the deviation rises more than lambda above its running
+// minimum (upward shift) or falls more than lambda below its running maximum
+// (downward shift). The test restarts on the new regime after each detection.
+class PageHinkleyDetector {
+public:
+    explicit PageHinkleyDetector(double delta = 0.05, double lambda = 0.5, size_t min_samples = 30)
+        : delta_(delta)
+        , lambda_(lambda)
+        , min_samples_(min_samples)
+        , sequence_(0)
+    {
+        reset();
+    }
+
+    bool update(double value, RegimeShiftEvent& event) {
+        uint64_t sequence = sequence_++;
+
+        samples_++;
+        mean_ += (value - mean_) / static_cast<double>(samples_);
+
+        cumulative_up_ += value - mean_ - delta_;
+        cumulative_down_ += value - mean_ + delta_;
+        min_up_ = std::min(min_up_, cumulative_up_);
+        max_down_ = std::max(max_down_, cumulative_down_);
+
+        if (samples_ < min_samples_) return false;
+
+        double up = cumulative_up_ - min_up_;
+        double down = max_down_ - cumulative_down_;
+        if (up <= lambda_ && down <= lambda_) return false;
+
+        bool rising = up > down;
+        event = RegimeShiftEvent{sequence, value, mean_, rising ? up : down,
+                                 rising ? RegimeShiftDirection::UP : RegimeShiftDirection::DOWN};
+        reset();
+        return true;
+    }
+
+    void reset() {
+        samples_ = 0;
+        mean_ = 0.0;
+        cumulative_up_ = 0.0;
+        cumulative_down_ = 0.0;
+        min_up_ = 0.0;
+        max_down_ = 0.0;
+    }
+
+    double get_mean() const { return mean_; }
+
+private:
+    double delta_;
+    double lambda_;
+    size_t min_samples_;
+    uint64_t sequence_;
+
+    size_t samples_;
+    double mean_;
+    double cumulative_up_;
+    double cumulative_down_;
+    double min_up_;
+    double max_down_;
+};
+
+// Two-sided tabular CUSUM against a slowly tracked baseline. The baseline is
+// the mean of the first warmup samples, then an EWMA that only moves while no
+// excursion is building. S+ / S- accumulate deviations beyond the slack k and a
+// shift is reported when either exceeds h.
+class CusumDetector {
+public:
+    explicit CusumDetector(double slack = 0.05, double threshold = 0.5,
+                           double baseline_smoothing = 0.01, size_t warmup = 30)
+        : slack_(slack)
+        , threshold_(threshold)
+        , baseline_smoothing_(baseline_smoothing)
+        , warmup_(std::max<size_t>(warmup, 1))
+        , sequence_(0)
+    {
+        reset();
+    }
+
+    bool update(double value, RegimeShiftEvent& event) {
+        uint64_t sequence = sequence_++;
+
+        if (samples_ < warmup_) {
+            samples_++;
+            baseline_ += (value - baseline_) / static_cast<double>(samples_);
+            return false;
+        }
+
+        upper_ = std::max(0.0, upper_ + value - baseline_ - slack_);
+        lower_ = std::max(0.0, lower_ + baseline_ - value - slack_);
+
+        if (upper_ > threshold_ || lower_ > threshold_) {
+            bool rising = upper_ > lower_;
+            event = RegimeShiftEvent{sequence, value, baseline_, rising ? upper_ : lower_,
+                                     rising ? RegimeShiftDirection::UP : RegimeShiftDirection::DOWN};
+            reset();
+            return true;
+        }
+
+        if (upper_ == 0.0 && lower_ == 0.0) {
+            baseline_ += baseline_smoothing_ * (value - baseline_);
+        }
+        return false;
+    }
+
+    void reset() {
+        samples_ = 0;
+        baseline_ = 0.0;
+        upper_ = 0.0;
+        lower_ = 0.0;
+    }
+
+    double get_baseline() const { return baseline_; }
+
+private:
+    double slack_;
+    double threshold_;
+    double baseline_smoothing_;
+    size_t warmup_;
+    uint64_t sequence_;
+
+    size_t samples_;
+    double baseline_;
+    double upper_;
+    double lower_;
+};
+
+// Bayesian online change-point detection (Adams & MacKay) with a Gaussian
+// observation model of known noise and a conjugate Normal prior on each
+// regime's mean, under a constant hazard. The run-length posterior is
+// truncated to MaxRunLength entries, so state is fixed-size and an update is
+// O(MaxRunLength). A shift is reported when the posterior mass on run lengths
+// of at most recent_run first exceeds the threshold, i.e. the data now favour
+// a regime that began only a few updates ago.
+template <size_t MaxRunLength = 64>
+class BayesianChangePointDetector {
+public:
+    explicit BayesianChangePointDetector(double expected_run_length = 200.0,
+                                         double noise_stddev = 0.05,
+                                         double prior_stddev = 0.5,
+                                         double threshold = 0.5,
+                                         size_t recent_run = 3)
+        : hazard_(1.0 / std::max(expected_run_length, 1.0))
+        , noise_var_(noise_stddev * noise_stddev)
+        , prior_var_(prior_stddev * prior_stddev)
+        , threshold_(threshold)
+        , recent_run_(std::min(recent_run, MaxRunLength - 1))
+        , sequence_(0)
+    {
+        reset();
+    }
+
+    bool update(double value, RegimeShiftEvent& event) {
+        uint64_t sequence = sequence_++;
+
+        if (!initialized_) {
+            means_[0] = value;
+            baseline_mean_ = value;
+            initialized_ = true;
+            return false;
+        }
+
+        // Predictive likelihood of value under each run's posterior mean
+        std::array<double, MaxRunLength> likelihood{};
+        for (size_t r = 0; r < active_; ++r) {
+            double var = variances_[r] + noise_var_;
+            double diff = value - means_[r];
+            likelihood[r] = std::exp(-0.5 * diff * diff / var) / std::sqrt(var);
+        }
+
+        // Grow runs by one, or cut to zero with probability hazard
+        std::array<double, MaxRunLength> next{};
+        double changepoint = 0.0;
+        for (size_t r = 0; r < active_; ++r) {
+            double mass = probabilities_[r] * likelihood[r];
+            changepoint += mass * hazard_;
+            size_t grown = std::min(r + 1, MaxRunLength - 1);
+            next[grown] += mass * (1.0 - hazard_);
+        }
+        next[0] = changepoint;
+
+        double total = 0.0;
+        for (double p : next) total += p;
+        if (!(total > 0.0)) {
+            reset();
+            return false;
+        }
+        for (double& p : next) p /= total;
+
+        // Conjugate Normal update of each surviving run's mean. The two longest
+        // runs both land in the last slot, so it keeps their mass-weighted blend.
+        std::array<double, MaxRunLength> means{};
+        std::array<double, MaxRunLength> variances{};
+        std::array<double, MaxRunLength> weights{};
+        means[0] = baseline_mean_;
+        variances[0] = prior_var_;
+        for (size_t r = 0; r < active_; ++r) {
+            size_t grown = std::min(r + 1, MaxRunLength - 1);
+            double var = 1.0 / (1.0 / variances_[r] + 1.0 / noise_var_);
+            double mean = var * (means_[r] / variances_[r] + value / noise_var_);
+            double weight = probabilities_[r] * likelihood[r] + 1e-300;
+
+            double combined = weights[grown] + weight;
+            means[grown] = (means[grown] * weights[grown] + mean * weight) / combined;
+            variances[grown] = (variances[grown] * weights[grown] + var * weight) / combined;
+            weights[grown] = combined;
+        }
+
+        double previous_baseline = expected_mean();
+        probabilities_ = next;
+        means_ = means;
+        variances_ = variances;
+        active_ = std::min(active_ + 1, MaxRunLength);
+
+        double recent = 0.0;
+        for (size_t r = 0; r <= recent_run_; ++r) recent += probabilities_[r];
+
+        bool detected = recent > threshold_ && !in_shift_;
+        in_shift_ = recent > threshold_;
+        if (!detected) return false;
+
+        event = RegimeShiftEvent{sequence, value, previous_baseline, recent,
+                                 value >= previous_baseline ? RegimeShiftDirection::UP : RegimeShiftDirection::DOWN};
+        baseline_mean_ = value;
+        return true;
+    }
+
+    void reset() {
+        probabilities_.fill(0.0);
+        means_.fill(0.0);
+        variances_.fill(prior_var_);
+        probabilities_[0] = 1.0;
+        active_ = 1;
+        initialized_ = false;
+        in_shift_ = true;  // the first regime is young too; wait for it to settle
+        baseline_mean_ = 0.0;
+    }
+
+    // Most probable run length (updates since the last change point)
+    size_t get_map_run_length() const {
+        return static_cast<size_t>(std::max_element(probabilities_.begin(), probabilities_.begin() + active_)
+                                   - probabilities_.begin());
+    }
+
+private:
+    // Posterior-weighted regime mean
+    double expected_mean() const {
+        double mean = 0.0;
+        for (size_t r = 0; r < active_; ++r) mean += probabilities_[r] * means_[r];
+        return mean;
+    }
+
+    double hazard_;
+    double noise_var_;
+    double prior_var_;
+    double threshold_;
+    size_t recent_run_;
+    uint64_t sequence_;
+
+    std::array<double, MaxRunLength> probabilities_;
+    std::array<double, MaxRunLength> means_;
+    std::array<double, MaxRunLength> variances_;
+    size_t active_;
+    bool initialized_;
+    bool in_shift_;
+    double baseline_mean_;
+};
+
+#endif // CHANGE_POINT_DETECTOR_HPP
@@ -0,0 +1,35 @@
+#ifndef COLUMN_CODEC_HPP
+#define COLUMN_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compression codecs for archived columns. Encoders append to out; decoders
+// take the exact value count and return false on truncated or corrupt input.
+//
+// Action codec (one state index 0..2 per byte): a sequence of segments, each
+// a tag byte and a LEB128 count.
+//   0x00          literal: count actions packed 2 bits each, 4 per byte, LSB first
+//   0x40 | action run: count copies of action
+// Runs of kActionMinRun or more become run segments, everything else is
+// literal, so the worst case is about 2 bits per action. Literals decode with
+// SSE2, 64 actions per 16 packed bytes, and runs decode as memset.
+//
+// Delta codec (integer ticks, timestamps): blocks of kDeltaBlockSize values,
+// each the first value as a little-endian i64, a bit width, then the zigzag
+// deltas of the remaining values packed at that width. The encoded stream
+// ends in 8 zero bytes so the decoder can always load a whole 64-bit word.
+// Decode unpacks a block's deltas, then integrates them with an SSE2 prefix
+// sum and a scalar tail.
+
+constexpr size_t kActionMinRun = 32;
+constexpr size_t kDeltaBlockSize = 128;
+
+void encode_actions(const uint8_t* actions, size_t count, std::vector<uint8_t>& out);
+bool decode_actions(const uint8_t* in, size_t size, size_t count, uint8_t* out);
+
+void encode_deltas(const int64_t* values, size_t count, std::vector<uint8_t>& out);
+bool decode_deltas(const uint8_t* in, size_t size, size_t count, int64_t* out);
+
+#endif // COLUMN_CODEC_HPP
@@ -0,0 +1,63 @@
+#ifndef COUNTING_MEMORY_RESOURCE_HPP
+#define COUNTING_MEMORY_RESOURCE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Snapshot of a CountingMemoryResource
+struct AllocationStats {
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t bytes_allocated;  // cumulative
+    uint64_t bytes_in_use;
+};
+
+// Pass-through memory_resource that counts what reaches its upstream. Placed
+// under the pools and arenas, it shows whether a steady state is malloc-free:
+// allocations stop growing once the pools are warm. Thread-safe if upstream is.
+class CountingMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit CountingMemoryResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream)
+    {}
+
+    AllocationStats get_stats() const {
+        return AllocationStats{allocations_.load(std::memory_order_relaxed),
+                               deallocations_.load(std::memory_order_relaxed),
+                               bytes_allocated_.load(std::memory_order_relaxed),
+                               bytes_in_use_.load(std::memory_order_relaxed)};
+    }
+
+    std::pmr::memory_resource* upstream() const {
+        return upstream_;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream_->allocate(bytes, alignment);
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        bytes_in_use_.fetch_add(bytes, std::memory_order_relaxed);
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> deallocations_{0};
+    std::atomic<uint64_t> bytes_allocated_{0};
+    std::atomic<uint64_t> bytes_in_use_{0};
+};
+
+#endif // COUNTING_MEMORY_RESOURCE_HPP
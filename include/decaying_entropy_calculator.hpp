@@ -0,0 +1,114 @@
+#ifndef DECAYING_ENTROPY_CALCULATOR_HPP
+#define DECAYING_ENTROPY_CALCULATOR_HPP
+
+#include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Entropy over exponentially decayed action counts (EWMA counts).
+// Each action adds weight 1 to its bin, and every bin halves once per
+// half-life. Decay is applied lazily from the last timestamp on update or
+// read, so the state is one double per state plus a timestamp and there is
+// no window buffer. Intended for very large symbol universes where even a
+// packed per-symbol window is too much memory. Measure and alphabet are
+// template parameters as in BasicSlidingEntropyCalculator; the measure sees
+// the decayed weights through evaluate_weighted_entropy().
+//
+// Not internally synchronized: one instance is owned by one consumer thread.
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+class BasicDecayingEntropyCalculator {
+public:
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+
+    explicit BasicDecayingEntropyCalculator(std::chrono::nanoseconds half_life = std::chrono::seconds(1))
+        : weights_{}
+        , last_timestamp_ns_(0)
+        , decay_per_ns_(decay_rate(half_life))
+    {}
+
+    // Decay to the event time, then add unit weight to the action's bin.
+    // Timestamps earlier than the last one are treated as simultaneous.
+    void add_action(action_type action, uint64_t timestamp_ns) {
+        decay_to(timestamp_ns);
+        weights_[static_cast<size_t>(action)] += 1.0;
+    }
+
+    void add_actions_batch(const std::vector<action_type>& actions, uint64_t timestamp_ns) {
+        decay_to(timestamp_ns);
+        for (const auto& action : actions) {
+            weights_[static_cast<size_t>(action)] += 1.0;
+        }
+    }
+
+    // Entropy of the decayed distribution. Uniform decay does not change the
+    // bin proportions, so no timestamp is needed to read it.
+    double get_current_entropy() const {
+        return evaluate_weighted_entropy<Measure>(weights_);
+    }
+
+    // Effective number of actions still in the estimate as of now_timestamp_ns
+    double get_effective_count(uint64_t now_timestamp_ns) const {
+        double total = 0.0;
+        for (double weight : weights_) total += weight;
+        return total * decay_factor(now_timestamp_ns);
+    }
+
+    // Decayed per-bin weights as of now_timestamp_ns, indexed by state
+    std::array<double, States> get_action_distribution(uint64_t now_timestamp_ns) const {
+        double factor = decay_factor(now_timestamp_ns);
+        std::array<double, States> weights = weights_;
+        for (double& weight : weights) weight *= factor;
+        return weights;
+    }
+
+    bool is_high_entropy() const { return get_current_entropy() > EntropyScale<States>::high_threshold; }
+    bool is_low_entropy() const { return get_current_entropy() < EntropyScale<States>::low_threshold; }
+    bool is_medium_entropy() const {
+        double entropy = get_current_entropy();
+        return entropy >= EntropyScale<States>::low_threshold && entropy <= EntropyScale<States>::high_threshold;
+    }
+
+    // Rescales the decay going forward; existing weights are kept as-is
+    void set_half_life(std::chrono::nanoseconds half_life) {
+        decay_per_ns_ = decay_rate(half_life);
+    }
+
+    void clear() {
+        weights_.fill(0.0);
+        last_timestamp_ns_ = 0;
+    }
+
+private:
+    // log2 decay per nanosecond; a non-positive half-life keeps only the latest instant
+    static double decay_rate(std::chrono::nanoseconds half_life) {
+        return half_life.count() > 0 ? 1.0 / static_cast<double>(half_life.count()) : INFINITY;
+    }
+
+    double decay_factor(uint64_t now_timestamp_ns) const {
+        if (now_timestamp_ns <= last_timestamp_ns_) return 1.0;
+        double elapsed = static_cast<double>(now_timestamp_ns - last_timestamp_ns_);
+        return std::exp2(-elapsed * decay_per_ns_);
+    }
+
+    void decay_to(uint64_t timestamp_ns) {
+        if (timestamp_ns <= last_timestamp_ns_) return;
+
+        double factor = decay_factor(timestamp_ns);
+        for (double& weight : weights_) {
+            weight *= factor;
+        }
+        last_timestamp_ns_ = timestamp_ns;
+    }
+
+    std::array<double, States> weights_;
+    uint64_t last_timestamp_ns_;
+    double decay_per_ns_;
+};
+
+using DecayingEntropyCalculator = BasicDecayingEntropyCalculator<>;
+
+#endif // DECAYING_ENTROPY_CALCULATOR_HPP
@@ -1,25 +1,113 @@
 #ifndef ENTROPY_CALCULATOR_HPP
 #define ENTROPY_CALCULATOR_HPP
 
+#include <array>
+#include <cstddef>
+#include <optional>
 #include <vector>
 #include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include "thread_pool.hpp"
 
-class EntropyCalculator {
+// Histogram of HOLD/BUY/SELL counts over an action sequence (SIMD where available)
+std::array<uint32_t, 3> count_trader_actions(const TraderAction* actions, size_t count);
+std::array<uint32_t, 3> count_trader_actions(const std::vector<TraderAction>& actions);
+
+// Histogram of an action sequence over an alphabet of States symbols
+template <size_t States>
+std::array<uint32_t, States> count_actions(const typename ActionAlphabet<States>::symbol_type* actions, size_t count) {
+    if constexpr (States == kTraderActionCount) {
+        return count_trader_actions(actions, count);
+    } else {
+        std::array<uint32_t, States> counts{};
+        for (size_t i = 0; i < count; ++i) {
+            counts[static_cast<size_t>(actions[i])]++;
+        }
+        return counts;
+    }
+}
+
+template <size_t States>
+std::array<uint32_t, States> count_actions(const std::vector<typename ActionAlphabet<States>::symbol_type>& actions) {
+    return count_actions<States>(actions.data(), actions.size());
+}
+
+// One-shot entropy over a whole action sequence. The entropy functional is a
+// compile-time policy from entropy_measures.hpp and the alphabet size is a
+// template parameter; Shannon over HOLD/BUY/SELL is what EntropyCalculator
+// refers to.
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+class BasicEntropyCalculator {
 public:
-    EntropyCalculator() = default;
-    ~EntropyCalculator() = default;
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+
+    BasicEntropyCalculator() = default;
+    ~BasicEntropyCalculator() = default;
     
-    EntropyCalculator(const EntropyCalculator&) = delete;
-    EntropyCalculator& operator=(const EntropyCalculator&) = delete;
+    BasicEntropyCalculator(const BasicEntropyCalculator&) = delete;
+    BasicEntropyCalculator& operator=(const BasicEntropyCalculator&) = delete;
     
-    double calculate_entropy(const std::vector<TraderAction>& actions);
+    // Entropy of actions under Measure; returns 0 if empty
+    double calculate_entropy(const std::vector<action_type>& actions) {
+        return calculate_entropy(actions.data(), actions.size());
+    }
+
+    // Pointer-range form for buffers that are not vectors (C++17 has no std::span)
+    double calculate_entropy(const action_type* actions, size_t count) {
+        return evaluate_entropy<Measure>(count_actions<States>(actions, count),
+                                         static_cast<uint32_t>(count));
+    }
+
+    double calculate_entropy(const action_type* first, const action_type* last) {
+        return calculate_entropy(first, static_cast<size_t>(last - first));
+    }
+
+    // Directly over a wire payload (one state index per byte). Empty if any
+    // byte is not a TraderAction; views from WireReader and TickStoreReader
+    // are already validated and always pass.
+    std::optional<double> calculate_entropy(const MarketDataView& view) {
+        static_assert(States >= kTraderActionCount, "view actions are TraderActions");
+        if (!valid_action_bytes(view.data(), view.size())) return std::nullopt;
+
+        return calculate_entropy(reinterpret_cast<const action_type*>(view.data()), view.size());
+    }
+
+    // Entropies of many sequences packed into one flat buffer: sequence i is
+    // actions[offsets[i], offsets[i + 1]), so offsets holds count + 1 entries.
+    // Results go to out[0, count).
+    void calculate_entropies_batch(const action_type* actions, const size_t* offsets,
+                                   size_t count, double* out) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = calculate_entropy(actions + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+
+    // Same, spread over a pool in chunks of chunk_size sequences. Each chunk
+    // writes a disjoint slice of out, so no synchronization is needed.
+    void calculate_entropies_batch(const action_type* actions, const size_t* offsets,
+                                   size_t count, double* out,
+                                   ThreadPool& pool, size_t chunk_size = 4096) {
+        pool.parallel_for(count, chunk_size, [&](size_t begin, size_t end) {
+            calculate_entropies_batch(actions, offsets + begin, end - begin, out + begin);
+        });
+    }
+
+    // Several measures from one shared histogram, e.g.
+    // calculate_entropies<ShannonEntropy, CollisionEntropy, MinEntropy>(actions)
+    template <typename... Measures>
+    std::array<double, sizeof...(Measures)> calculate_entropies(const std::vector<action_type>& actions) {
+        return EntropyMeasureSet<Measures...>::evaluate(count_actions<States>(actions),
+                                                        static_cast<uint32_t>(actions.size()));
+    }
     
-    static double get_max_entropy() { return 1.585; }
-    static bool is_high_entropy(double entropy) { return entropy > 1.2; }
-    static bool is_low_entropy(double entropy) { return entropy < 0.5; }
-    static bool is_medium_entropy(double entropy) { 
-        return entropy >= 0.5 && entropy <= 1.2; 
+    static constexpr double get_max_entropy() { return EntropyScale<States>::max_entropy; }
+    static constexpr bool is_high_entropy(double entropy) { return entropy > EntropyScale<States>::high_threshold; }
+    static constexpr bool is_low_entropy(double entropy) { return entropy < EntropyScale<States>::low_threshold; }
+    static constexpr bool is_medium_entropy(double entropy) { 
+        return entropy >= EntropyScale<States>::low_threshold && entropy <= EntropyScale<States>::high_threshold; 
     }
 };
 
+using EntropyCalculator = BasicEntropyCalculator<>;
+
 #endif // ENTROPY_CALCULATOR_HPP
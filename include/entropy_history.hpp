@@ -0,0 +1,244 @@
+#ifndef ENTROPY_HISTORY_HPP
+#define ENTROPY_HISTORY_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+enum class HistoryResolution : uint8_t {
+    RAW = 0,
+    SECOND = 1,
+    MINUTE = 2,
+    HOUR = 3
+};
+
+// One downsampled bucket; for RAW queries every bucket holds a single sample
+struct EntropyRollup {
+    uint64_t start_ns;
+    double min;
+    double max;
+    double mean;
+    double last;
+    uint32_t count;
+};
+
+// Fixed-memory, multi-resolution entropy history: a raw ring of the most
+// recent samples plus 1s / 1m / 1h rollup rings (min, max, mean, last).
+// record() is O(1): it updates the open bucket of each tier in place and
+// starts a new bucket when a boundary is crossed. Samples stamped earlier than
+// the latest one are clamped to it, so rings stay in time order even if the
+// caller's clock steps back.
+//
+// Single writer, lock-free readers. Every ring slot carries its own sequence
+// counter (a per-slot seqlock), so readers never take a lock and the writer
+// never waits; a reader that races a slot update simply re-reads that slot.
+class EntropyHistory {
+public:
+    static constexpr uint64_t kSecondNs = 1000000000ull;
+
+    explicit EntropyHistory(size_t raw_capacity = 1024,
+                            size_t second_capacity = 900,
+                            size_t minute_capacity = 1440,
+                            size_t hour_capacity = 168)
+        : raw_(std::max<size_t>(raw_capacity, 1))
+        , tiers_{Tier(kSecondNs, second_capacity),
+                 Tier(60 * kSecondNs, minute_capacity),
+                 Tier(3600 * kSecondNs, hour_capacity)}
+        , latest_ns_(0)
+    {}
+
+    EntropyHistory(const EntropyHistory&) = delete;
+    EntropyHistory& operator=(const EntropyHistory&) = delete;
+
+    // Writer only. Timestamps are expected to be non-decreasing; a late one
+    // is recorded at the latest timestamp seen.
+    void record(uint64_t timestamp_ns, double value) {
+        timestamp_ns = std::max(timestamp_ns, latest_ns_);
+        latest_ns_ = timestamp_ns;
+
+        uint64_t index = raw_.count.load(std::memory_order_relaxed);
+        Slot& slot = raw_.slots[index % raw_.slots.size()];
+        write_slot(slot, index, Bucket{timestamp_ns, value, value, value, value, 1});
+        raw_.count.store(index + 1, std::memory_order_release);
+
+        for (Tier& tier : tiers_) {
+            record_rollup(tier, timestamp_ns, value);
+        }
+    }
+
+    // Most recent n raw values, newest first
+    std::vector<double> get_recent(size_t n) const {
+        std::vector<double> values;
+        uint64_t count = raw_.count.load(std::memory_order_acquire);
+        uint64_t available = std::min<uint64_t>(count, raw_.slots.size());
+        n = static_cast<size_t>(std::min<uint64_t>(n, available));
+        values.reserve(n);
+
+        for (uint64_t i = 0; i < n; ++i) {
+            uint64_t index = count - 1 - i;
+            Bucket bucket;
+            if (!read_slot(raw_.slots[index % raw_.slots.size()], index, bucket)) break;
+            values.push_back(bucket.last);
+        }
+        return values;
+    }
+
+    // Buckets overlapping [from_ns, to_ns] at the given resolution, oldest
+    // first. The newest rollup bucket may still be open (partial).
+    std::vector<EntropyRollup> query(HistoryResolution resolution, uint64_t from_ns, uint64_t to_ns) const {
+        if (resolution == HistoryResolution::RAW) {
+            return query_ring(raw_, 0, from_ns, to_ns);
+        }
+        const Tier& tier = tiers_[static_cast<size_t>(resolution) - 1];
+        return query_ring(tier.ring, tier.width_ns, from_ns, to_ns);
+    }
+
+    std::vector<EntropyRollup> query(HistoryResolution resolution) const {
+        return query(resolution, 0, std::numeric_limits<uint64_t>::max());
+    }
+
+    // Total samples ever recorded
+    uint64_t size() const {
+        return raw_.count.load(std::memory_order_acquire);
+    }
+
+    // Fixed footprint of all rings
+    size_t memory_usage_bytes() const {
+        size_t slots = raw_.slots.size();
+        for (const Tier& tier : tiers_) slots += tier.ring.slots.size();
+        return slots * sizeof(Slot);
+    }
+
+    // Writer only
+    void clear() {
+        raw_.count.store(0, std::memory_order_release);
+        for (Tier& tier : tiers_) {
+            tier.ring.count.store(0, std::memory_order_release);
+            tier.open = false;
+        }
+        latest_ns_ = 0;
+    }
+
+private:
+    struct Bucket {
+        uint64_t start_ns;
+        double min;
+        double max;
+        double sum;
+        double last;
+        uint32_t count;
+    };
+
+    // Field-wise atomics keep racing reads well-defined; seq is odd mid-write
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> index{0};
+        std::atomic<uint64_t> start_ns{0};
+        std::atomic<double> min{0.0};
+        std::atomic<double> max{0.0};
+        std::atomic<double> sum{0.0};
+        std::atomic<double> last{0.0};
+        std::atomic<uint32_t> count{0};
+    };
+
+    struct Ring {
+        explicit Ring(size_t capacity) : slots(std::max<size_t>(capacity, 1)), count(0) {}
+        std::vector<Slot> slots;
+        std::atomic<uint64_t> count;  // slots published so far
+    };
+
+    struct Tier {
+        Tier(uint64_t width, size_t capacity) : width_ns(width), ring(capacity), open(false), current{} {}
+        uint64_t width_ns;
+        Ring ring;
+        bool open;       // writer-private: ring's newest slot is the open bucket
+        Bucket current;  // writer-private copy of the open bucket
+    };
+
+    static void write_slot(Slot& slot, uint64_t index, const Bucket& bucket) {
+        uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.index.store(index, std::memory_order_relaxed);
+        slot.start_ns.store(bucket.start_ns, std::memory_order_relaxed);
+        slot.min.store(bucket.min, std::memory_order_relaxed);
+        slot.max.store(bucket.max, std::memory_order_relaxed);
+        slot.sum.store(bucket.sum, std::memory_order_relaxed);
+        slot.last.store(bucket.last, std::memory_order_relaxed);
+        slot.count.store(bucket.count, std::memory_order_relaxed);
+
+        slot.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // False if the slot no longer holds logical entry `index` (overwritten)
+    static bool read_slot(const Slot& slot, uint64_t index, Bucket& bucket) {
+        for (;;) {
+            uint64_t before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1) continue;
+
+            uint64_t stored_index = slot.index.load(std::memory_order_relaxed);
+            bucket.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+            bucket.min = slot.min.load(std::memory_order_relaxed);
+            bucket.max = slot.max.load(std::memory_order_relaxed);
+            bucket.sum = slot.sum.load(std::memory_order_relaxed);
+            bucket.last = slot.last.load(std::memory_order_relaxed);
+            bucket.count = slot.count.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == before) {
+                return stored_index == index;
+            }
+        }
+    }
+
+    static void record_rollup(Tier& tier, uint64_t timestamp_ns, double value) {
+        uint64_t start = timestamp_ns - timestamp_ns % tier.width_ns;
+        uint64_t count = tier.ring.count.load(std::memory_order_relaxed);
+
+        if (tier.open && start == tier.current.start_ns) {
+            Bucket& b = tier.current;
+            b.min = std::min(b.min, value);
+            b.max = std::max(b.max, value);
+            b.sum += value;
+            b.last = value;
+            b.count++;
+            write_slot(tier.ring.slots[(count - 1) % tier.ring.slots.size()], count - 1, b);
+            return;
+        }
+
+        // Crossing a boundary closes the open bucket simply by leaving it behind
+        tier.current = Bucket{start, value, value, value, value, 1};
+        tier.open = true;
+        write_slot(tier.ring.slots[count % tier.ring.slots.size()], count, tier.current);
+        tier.ring.count.store(count + 1, std::memory_order_release);
+    }
+
+    static std::vector<EntropyRollup> query_ring(const Ring& ring, uint64_t width_ns,
+                                                 uint64_t from_ns, uint64_t to_ns) {
+        std::vector<EntropyRollup> result;
+        uint64_t count = ring.count.load(std::memory_order_acquire);
+        uint64_t available = std::min<uint64_t>(count, ring.slots.size());
+
+        for (uint64_t index = count - available; index < count; ++index) {
+            Bucket bucket;
+            if (!read_slot(ring.slots[index % ring.slots.size()], index, bucket)) continue;
+            uint64_t end_ns = bucket.start_ns + width_ns;  // exclusive; raw samples are points
+            bool before_range = width_ns > 0 ? end_ns <= from_ns : bucket.start_ns < from_ns;
+            if (before_range || bucket.start_ns > to_ns) continue;
+
+            result.push_back(EntropyRollup{bucket.start_ns, bucket.min, bucket.max,
+                                           bucket.sum / bucket.count, bucket.last, bucket.count});
+        }
+        return result;
+    }
+
+    Ring raw_;
+    std::array<Tier, 3> tiers_;
+    uint64_t latest_ns_;  // writer-private
+};
+
+#endif // ENTROPY_HISTORY_HPP
@@ -0,0 +1,81 @@
+#ifndef ENTROPY_MATH_HPP
+#define ENTROPY_MATH_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Shared helpers for engines that keep entropy incrementally as
+// S = sum(c * log2 c) over bin counts, so that H = log2(N) - S / N and a
+// single count change only touches S by f(c +/- 1) - f(c).
+
+// log2 usable in constant expressions (std::log2 is not constexpr in C++17).
+// Scales x into [1, 2) and sums the atanh series for ln; accurate to a few ulp.
+constexpr double constexpr_log2(double x) {
+    if (x <= 0.0) return 0.0;
+
+    int exponent = 0;
+    while (x >= 2.0) { x /= 2.0; ++exponent; }
+    while (x < 1.0) { x *= 2.0; --exponent; }
+
+    double y = (x - 1.0) / (x + 1.0);
+    double y2 = y * y;
+    double term = y;
+    double ln = 0.0;
+    for (int k = 1; term > 1e-18; k += 2) {
+        ln += term / k;
+        term *= y2;
+    }
+    return exponent + 2.0 * ln / 0.693147180559945309417232121458;
+}
+
+// log2(n) for n in [0, N), with log2(0) treated as 0
+template <size_t N>
+constexpr std::array<double, N> make_log2_table() {
+    std::array<double, N> table{};
+    for (size_t n = 1; n < N; ++n) {
+        table[n] = constexpr_log2(static_cast<double>(n));
+    }
+    return table;
+}
+
+// Compile-time log2 table covering every count in a default-sized window
+inline constexpr size_t kLog2TableSize = 4096;
+inline constexpr std::array<double, kLog2TableSize> kLog2Table = make_log2_table<kLog2TableSize>();
+
+// log2(n) from the table when n is small enough
+inline double fast_log2(uint64_t n) {
+    return n < kLog2TableSize ? kLog2Table[n] : std::log2(static_cast<double>(n));
+}
+
+// c * log2(c), with 0 * log2(0) = 0
+inline double count_log2_count(uint64_t count) {
+    return count > 1 ? static_cast<double>(count) * std::log2(static_cast<double>(count)) : 0.0;
+}
+
+// Shannon entropy (bits) from S = sum(c * log2 c) and N = sum(c)
+inline double entropy_from_count_sum(double count_log_sum, uint64_t total) {
+    if (total == 0) return 0.0;
+    double entropy = fast_log2(total) - count_log_sum / static_cast<double>(total);
+    return entropy > 0.0 ? entropy : 0.0;  // clamp rounding noise at H = 0
+}
+
+// Table of c * log2(c) for c in [0, max_count], built once per engine so the
+// per-action update is a pair of table lookups instead of two log2 calls
+inline std::vector<double> make_count_log2_table(size_t max_count) {
+    std::vector<double> table(max_count + 1);
+    for (size_t c = 0; c <= max_count; ++c) {
+        table[c] = count_log2_count(c);
+    }
+    return table;
+}
+
+// c * log2(c) from the shared compile-time table for small counts. Engines that
+// exist in large numbers (one per symbol or pair) use this instead of owning a table.
+inline double count_log2_count_cached(uint64_t count) {
+    return static_cast<double>(count) * fast_log2(count);
+}
+
+#endif // ENTROPY_MATH_HPP
@@ -0,0 +1,254 @@
+#ifndef ENTROPY_MEASURES_HPP
+#define ENTROPY_MEASURES_HPP
+
+#include "entropy_math.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Entropy functionals used as compile-time policies by EntropyCalculator and
+// SlidingEntropyCalculator. Each measure folds bin counts into an accumulator
+// and finishes it once:
+//
+//   using accumulator_type = ...;
+//   static constexpr accumulator_type initial();
+//   static void accumulate(accumulator_type& acc, uint32_t count, uint32_t total);
+//   static double finalize(const accumulator_type& acc, uint32_t total);
+//
+// Measures that can also take real-valued weights (decayed counts) provide
+//
+//   static void accumulate_weight(accumulator_type& acc, double weight, double total);
+//   static double finalize_weighted(const accumulator_type& acc, double total);
+//
+// Because accumulation is split from finalization, several measures can be
+// evaluated from one shared count array in a single pass (see EntropyMeasureSet).
+
+namespace entropy_detail {
+
+template <unsigned Exponent>
+constexpr double power(double base) {
+    double result = 1.0;
+    for (unsigned i = 0; i < Exponent; ++i) result *= base;
+    return result;
+}
+
+} // namespace entropy_detail
+
+// Shannon entropy H = -sum p log2 p, in bits. Accumulates S = sum c log2 c
+// from the compile-time log table and finishes as log2(N) - S / N, so window
+// sized counts never call std::log2.
+struct ShannonEntropy {
+    using accumulator_type = double;
+
+    static constexpr accumulator_type initial() { return 0.0; }
+
+    static void accumulate(accumulator_type& acc, uint32_t count, uint32_t) {
+        acc += count_log2_count_cached(count);  // Entropy contribution
+    }
+
+    static double finalize(const accumulator_type& acc, uint32_t total) {
+        return entropy_from_count_sum(acc, total);
+    }
+
+    // H = log2(W) - sum w log2 w / W over weights summing to W
+    static void accumulate_weight(accumulator_type& acc, double weight, double) {
+        if (weight > 0.0) acc += weight * std::log2(weight);
+    }
+
+    static double finalize_weighted(const accumulator_type& acc, double total) {
+        return std::max(std::log2(total) - acc / total, 0.0);
+    }
+};
+
+// Renyi entropy of integer order Alpha >= 2: H_a = log2(sum p^a) / (1 - a), in bits.
+// Only one log per evaluation, none per bin.
+template <unsigned Alpha>
+struct RenyiEntropy {
+    static_assert(Alpha >= 2, "Renyi order must be >= 2; use ShannonEntropy for order 1");
+
+    using accumulator_type = double;
+
+    static constexpr accumulator_type initial() { return 0.0; }
+
+    static void accumulate(accumulator_type& acc, uint32_t count, uint32_t total) {
+        acc += entropy_detail::power<Alpha>(static_cast<double>(count) / total);
+    }
+
+    static double finalize(const accumulator_type& acc, uint32_t) {
+        return acc > 0.0 ? -std::log2(acc) / (Alpha - 1) : 0.0;
+    }
+
+    static void accumulate_weight(accumulator_type& acc, double weight, double total) {
+        acc += entropy_detail::power<Alpha>(weight / total);
+    }
+
+    static double finalize_weighted(const accumulator_type& acc, double) {
+        return acc > 0.0 ? -std::log2(acc) / (Alpha - 1) : 0.0;
+    }
+};
+
+// Collision entropy, -log2 sum p^2
+using CollisionEntropy = RenyiEntropy<2>;
+
+// Min-entropy (Renyi order infinity), -log2 max p; driven by the dominant side
+struct MinEntropy {
+    using accumulator_type = double;
+
+    static constexpr accumulator_type initial() { return 0.0; }
+
+    static void accumulate(accumulator_type& acc, uint32_t count, uint32_t) {
+        acc = std::max(acc, static_cast<double>(count));
+    }
+
+    static double finalize(const accumulator_type& acc, uint32_t total) {
+        return acc > 0.0 ? -std::log2(acc / total) : 0.0;
+    }
+
+    static void accumulate_weight(accumulator_type& acc, double weight, double) {
+        acc = std::max(acc, weight);
+    }
+
+    static double finalize_weighted(const accumulator_type& acc, double total) {
+        return acc > 0.0 ? -std::log2(acc / total) : 0.0;
+    }
+};
+
+// Tsallis entropy of integer order Q >= 2: S_q = (1 - sum p^q) / (q - 1).
+// Dimensionless, not bits; the regime thresholds do not apply to it.
+template <unsigned Q>
+struct TsallisEntropy {
+    static_assert(Q >= 2, "Tsallis order must be >= 2");
+
+    using accumulator_type = double;
+
+    static constexpr accumulator_type initial() { return 0.0; }
+
+    static void accumulate(accumulator_type& acc, uint32_t count, uint32_t total) {
+        acc += entropy_detail::power<Q>(static_cast<double>(count) / total);
+    }
+
+    static double finalize(const accumulator_type& acc, uint32_t) {
+        return (1.0 - acc) / (Q - 1);
+    }
+
+    static void accumulate_weight(accumulator_type& acc, double weight, double total) {
+        acc += entropy_detail::power<Q>(weight / total);
+    }
+
+    static double finalize_weighted(const accumulator_type& acc, double) {
+        return (1.0 - acc) / (Q - 1);
+    }
+};
+
+// Alphabets up to this size have their per-bin loops expanded at compile time
+constexpr size_t kUnrolledAlphabetLimit = 16;
+
+namespace entropy_detail {
+
+template <typename Measure, size_t N, size_t... I>
+void accumulate_unrolled(typename Measure::accumulator_type& acc, const std::array<uint32_t, N>& counts,
+                         uint32_t total, std::index_sequence<I...>) {
+    (Measure::accumulate(acc, counts[I], total), ...);
+}
+
+} // namespace entropy_detail
+
+// Evaluate one measure over a count array; 0 for an empty histogram
+template <typename Measure, size_t N>
+double evaluate_entropy(const std::array<uint32_t, N>& counts, uint32_t total) {
+    if (total == 0) return 0.0;
+
+    typename Measure::accumulator_type acc = Measure::initial();
+    if constexpr (N <= kUnrolledAlphabetLimit) {
+        entropy_detail::accumulate_unrolled<Measure>(acc, counts, total, std::make_index_sequence<N>{});
+    } else {
+        for (uint32_t count : counts) {
+            Measure::accumulate(acc, count, total);
+        }
+    }
+    return Measure::finalize(acc, total);
+}
+
+namespace entropy_detail {
+
+template <typename Measure, typename = void>
+struct has_weighted_form : std::false_type {};
+
+template <typename Measure>
+struct has_weighted_form<Measure, std::void_t<decltype(Measure::finalize_weighted(
+                                      std::declval<const typename Measure::accumulator_type&>(), 1.0))>>
+    : std::true_type {};
+
+} // namespace entropy_detail
+
+// Weight total that weights are scaled to for measures that only take
+// integer counts; rounding moves each probability by at most 2^-25
+constexpr uint32_t kWeightResolution = uint32_t{1} << 24;
+
+// Evaluate one measure over real-valued bin weights (e.g. decayed counts).
+// Measures with a weighted form are computed exactly from the doubles;
+// integer-only measures (FixedPointShannonEntropy) see the weights rounded to
+// counts totalling kWeightResolution. 0 if all weights are 0.
+template <typename Measure, size_t N>
+double evaluate_weighted_entropy(const std::array<double, N>& weights) {
+    double total = 0.0;
+    for (double weight : weights) total += std::max(weight, 0.0);
+    if (!(total > 0.0)) return 0.0;
+
+    if constexpr (entropy_detail::has_weighted_form<Measure>::value) {
+        typename Measure::accumulator_type acc = Measure::initial();
+        for (double weight : weights) {
+            Measure::accumulate_weight(acc, std::max(weight, 0.0), total);
+        }
+        return Measure::finalize_weighted(acc, total);
+    }
+
+    std::array<uint32_t, N> counts{};
+    uint32_t count_total = 0;
+    double scale = kWeightResolution / total;
+    for (size_t i = 0; i < N; ++i) {
+        counts[i] = static_cast<uint32_t>(std::lround(std::max(weights[i], 0.0) * scale));
+        count_total += counts[i];
+    }
+    return evaluate_entropy<Measure>(counts, count_total);
+}
+
+// Maximum entropy and regime thresholds for an alphabet of States symbols.
+// The three-state thresholds are the repo's 0.5 / 1.2 bits; larger alphabets
+// keep the same fraction of their log2(States) maximum.
+template <size_t States>
+struct EntropyScale {
+    static constexpr double max_entropy = constexpr_log2(static_cast<double>(States));
+    static constexpr double high_threshold = States == 3 ? 1.2 : max_entropy * (1.2 / constexpr_log2(3.0));
+    static constexpr double low_threshold = States == 3 ? 0.5 : max_entropy * (0.5 / constexpr_log2(3.0));
+};
+
+// Several measures over the same counts, visiting each bin once
+template <typename... Measures>
+struct EntropyMeasureSet {
+    static constexpr size_t size = sizeof...(Measures);
+
+    template <size_t N>
+    static std::array<double, size> evaluate(const std::array<uint32_t, N>& counts, uint32_t total) {
+        return evaluate(counts, total, std::index_sequence_for<Measures...>{});
+    }
+
+private:
+    template <size_t N, size_t... I>
+    static std::array<double, size> evaluate(const std::array<uint32_t, N>& counts, uint32_t total,
+                                             std::index_sequence<I...>) {
+        if (total == 0) return {};
+
+        std::tuple<typename Measures::accumulator_type...> accs{Measures::initial()...};
+        for (uint32_t count : counts) {
+            (Measures::accumulate(std::get<I>(accs), count, total), ...);
+        }
+        return {Measures::finalize(std::get<I>(accs), total)...};
+    }
+};
+
+#endif // ENTROPY_MEASURES_HPP
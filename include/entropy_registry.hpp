@@ -0,0 +1,270 @@
+#ifndef ENTROPY_REGISTRY_HPP
+#define ENTROPY_REGISTRY_HPP
+
+#include "market_data.hpp"
+#include "entropy_math.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Sliding-window Shannon entropy for a whole symbol universe (50k+ names).
+// Instead of one SlidingEntropyCalculator per symbol, each with its own mutex
+// and deques, state is stored structure-of-arrays: one contiguous array each
+// for bin counts, totals, S = sum(c log2 c), entropy, window cursors and the
+// ring-buffer action windows (one byte per action), indexed by a slot. Symbol
+// ids (see SymbolTable) map to slots through an open-addressed table kept at
+// most half full, so lookup is O(1) and memory depends on max_symbols only,
+// never on how large or sparse the ids are. A slot is created lazily on a
+// symbol's first action. Memory is bounded by max_memory_bytes() and reported
+// by memory_usage_bytes().
+//
+// Not internally synchronized: a registry is owned by one consumer thread,
+// typically one registry per shard of the symbol id space.
+template <size_t States = kTraderActionCount>
+class BasicEntropyRegistry {
+public:
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    explicit BasicEntropyRegistry(size_t window_size = 100, size_t max_symbols = 65536)
+        : window_size_(std::max<size_t>(window_size, 1))
+        , max_symbols_(max_symbols)
+    {}
+
+    BasicEntropyRegistry(const BasicEntropyRegistry&) = delete;
+    BasicEntropyRegistry& operator=(const BasicEntropyRegistry&) = delete;
+
+    // Add an action for symbol_id; false if the registry is full
+    bool add_action(uint32_t symbol_id, action_type action) {
+        uint32_t slot = slot_for(symbol_id);
+        if (slot == kNoSlot) return false;
+
+        push_action(slot, static_cast<uint8_t>(action));
+        return true;
+    }
+
+    bool add_actions_batch(uint32_t symbol_id, const std::vector<action_type>& actions) {
+        uint32_t slot = slot_for(symbol_id);
+        if (slot == kNoSlot) return false;
+
+        for (const auto& action : actions) {
+            push_action(slot, static_cast<uint8_t>(action));
+        }
+        return true;
+    }
+
+    // Entropy in bits for symbol_id; 0 if it has no actions yet
+    double get_entropy(uint32_t symbol_id) const {
+        uint32_t slot = find_slot(symbol_id);
+        return slot != kNoSlot ? entropy_[slot] : 0.0;
+    }
+
+    std::array<uint32_t, States> get_action_distribution(uint32_t symbol_id) const {
+        std::array<uint32_t, States> counts{};
+        uint32_t slot = find_slot(symbol_id);
+        if (slot != kNoSlot) {
+            std::copy_n(counts_.begin() + static_cast<size_t>(slot) * States, States, counts.begin());
+        }
+        return counts;
+    }
+
+    size_t get_window_size(uint32_t symbol_id) const {
+        uint32_t slot = find_slot(symbol_id);
+        return slot != kNoSlot ? totals_[slot] : 0;
+    }
+
+    bool contains(uint32_t symbol_id) const {
+        return find_slot(symbol_id) != kNoSlot;
+    }
+
+    // Number of symbols with state allocated
+    size_t symbol_count() const {
+        return slot_symbols_.size();
+    }
+
+    // Entropy of every allocated slot, parallel to get_slot_symbols(), for scans
+    const std::vector<double>& get_entropies() const {
+        return entropy_;
+    }
+
+    const std::vector<uint32_t>& get_slot_symbols() const {
+        return slot_symbols_;
+    }
+
+    // Bytes currently reserved by the registry's arrays
+    size_t memory_usage_bytes() const {
+        return slot_table_.capacity() * sizeof(uint32_t)
+             + slot_symbols_.capacity() * sizeof(uint32_t)
+             + counts_.capacity() * sizeof(uint32_t)
+             + totals_.capacity() * sizeof(uint32_t)
+             + cursors_.capacity() * sizeof(uint32_t)
+             + count_log_sums_.capacity() * sizeof(double)
+             + entropy_.capacity() * sizeof(double)
+             + windows_.capacity() * sizeof(uint8_t);
+    }
+
+    // Upper bound on memory_usage_bytes(): per-slot arrays never grow past
+    // max_symbols slots
+    size_t max_memory_bytes() const {
+        return max_symbols_ * bytes_per_symbol() + table_size_for(max_symbols_) * sizeof(uint32_t);
+    }
+
+    // Per-slot arrays only; the id -> slot table adds at most 4 entries per slot
+    size_t bytes_per_symbol() const {
+        return sizeof(uint32_t)                // slot -> id
+             + States * sizeof(uint32_t)       // counts
+             + 2 * sizeof(uint32_t)            // total, cursor
+             + 2 * sizeof(double)              // S, entropy
+             + window_size_ * sizeof(uint8_t); // window, one byte per action
+    }
+
+    size_t get_max_symbols() const {
+        return max_symbols_;
+    }
+
+    // Pre-size the arrays for n symbols to avoid growth on the hot path
+    void reserve(size_t n) {
+        n = std::min(n, max_symbols_);
+        if (table_size_for(n) > slot_table_.size()) rehash(table_size_for(n));
+        reserve_slots(n);
+    }
+
+    void clear() {
+        slot_table_.clear();
+        slot_symbols_.clear();
+        counts_.clear();
+        totals_.clear();
+        cursors_.clear();
+        count_log_sums_.clear();
+        entropy_.clear();
+        windows_.clear();
+    }
+
+private:
+    // Power of two with at least twice as many entries as slots
+    static size_t table_size_for(size_t slots) {
+        size_t size = 16;
+        while (size < 2 * slots) size *= 2;
+        return size;
+    }
+
+    static size_t hash_id(uint32_t symbol_id) {
+        return static_cast<size_t>((symbol_id * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    // Table position holding symbol_id's slot, or the empty position where it
+    // would go; the table is never full, so probing terminates
+    size_t probe(uint32_t symbol_id) const {
+        size_t mask = slot_table_.size() - 1;
+        size_t i = hash_id(symbol_id) & mask;
+        while (slot_table_[i] != kNoSlot && slot_symbols_[slot_table_[i]] != symbol_id) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t size) {
+        slot_table_.assign(size, kNoSlot);
+        for (uint32_t slot = 0; slot < slot_symbols_.size(); ++slot) {
+            slot_table_[probe(slot_symbols_[slot])] = slot;
+        }
+    }
+
+    // Exact-size reservation of every per-slot array. push_back growth would
+    // let capacity overshoot max_symbols and break max_memory_bytes().
+    void reserve_slots(size_t n) {
+        slot_symbols_.reserve(n);
+        counts_.reserve(n * States);
+        totals_.reserve(n);
+        cursors_.reserve(n);
+        count_log_sums_.reserve(n);
+        entropy_.reserve(n);
+        windows_.reserve(n * window_size_);
+    }
+
+    uint32_t find_slot(uint32_t symbol_id) const {
+        return slot_table_.empty() ? kNoSlot : slot_table_[probe(symbol_id)];
+    }
+
+    // Existing slot for symbol_id, or a new zeroed one if there is room
+    uint32_t slot_for(uint32_t symbol_id) {
+        uint32_t slot = find_slot(symbol_id);
+        if (slot != kNoSlot) return slot;
+        if (slot_symbols_.size() >= max_symbols_) return kNoSlot;
+
+        if (table_size_for(slot_symbols_.size() + 1) > slot_table_.size()) {
+            rehash(table_size_for(slot_symbols_.size() + 1));
+        }
+        // Geometric growth, capped at max_symbols
+        if (slot_symbols_.size() == slot_symbols_.capacity()) {
+            reserve_slots(std::min(max_symbols_, std::max<size_t>(16, 2 * slot_symbols_.size())));
+        }
+
+        slot = static_cast<uint32_t>(slot_symbols_.size());
+        slot_table_[probe(symbol_id)] = slot;
+        slot_symbols_.push_back(symbol_id);
+        counts_.insert(counts_.end(), States, 0);
+        totals_.push_back(0);
+        cursors_.push_back(0);
+        count_log_sums_.push_back(0.0);
+        entropy_.push_back(0.0);
+        windows_.insert(windows_.end(), window_size_, 0);
+        return slot;
+    }
+
+    void push_action(uint32_t slot, uint8_t state) {
+        uint32_t* counts = counts_.data() + static_cast<size_t>(slot) * States;
+        uint8_t* window = windows_.data() + static_cast<size_t>(slot) * window_size_;
+        uint32_t& cursor = cursors_[slot];
+        uint32_t& total = totals_[slot];
+        double& count_log_sum = count_log_sums_[slot];
+
+        // Full window: the cursor points at the oldest action
+        if (total == window_size_) {
+            uint32_t& oldest = counts[window[cursor]];
+            count_log_sum += count_log2_count_cached(oldest - 1) - count_log2_count_cached(oldest);
+            oldest--;
+            total--;
+        }
+
+        uint32_t& count = counts[state];
+        count_log_sum += count_log2_count_cached(count + 1) - count_log2_count_cached(count);
+        count++;
+        total++;
+
+        window[cursor] = state;
+        cursor = static_cast<uint32_t>((cursor + 1) % window_size_);
+
+        // Once per lap of the window, rebuild S from the integer counts to bound drift
+        if (cursor == 0) {
+            count_log_sum = 0.0;
+            for (size_t i = 0; i < States; ++i) {
+                count_log_sum += count_log2_count_cached(counts[i]);
+            }
+        }
+
+        entropy_[slot] = entropy_from_count_sum(count_log_sum, total);
+    }
+
+    // Configuration parameters
+    size_t window_size_;
+    size_t max_symbols_;
+
+    // Symbol id -> slot (open addressing, kNoSlot = empty), and slot -> symbol id
+    std::vector<uint32_t> slot_table_;
+    std::vector<uint32_t> slot_symbols_;
+
+    // Per-slot state, structure-of-arrays
+    std::vector<uint32_t> counts_;        // States per slot
+    std::vector<uint32_t> totals_;
+    std::vector<uint32_t> cursors_;
+    std::vector<double> count_log_sums_;
+    std::vector<double> entropy_;
+    std::vector<uint8_t> windows_;        // window_size per slot
+};
+
+using EntropyRegistry = BasicEntropyRegistry<>;
+
+#endif // ENTROPY_REGISTRY_HPP
@@ -0,0 +1,129 @@
+#ifndef FIXED_POINT_ENTROPY_HPP
+#define FIXED_POINT_ENTROPY_HPP
+
+#include "entropy_math.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Integer Shannon entropy kernel for bit-exact replay across hosts and builds.
+// The double path depends on the platform's std::log2 and on floating point
+// division, so results can differ in the last bits between machines. Here every
+// step is integer arithmetic on a log2 table that is computed at compile time:
+//
+//   L(n) = log2(n) in Q32.32, exact to the nearest unit for n <= 8192 and
+//          linearly interpolated between table entries above that
+//   N * H = sum c * (L(N) - L(c))          (Q32.32, integer adds/multiplies)
+//   H     = round((N * H / N) >> 16)        (Q16.16 result)
+//
+// Error bound against the double path: the table entries are within 2^-33 of
+// log2(n), interpolation adds at most 2^-26 for counts above 8192, and the
+// final rounding to Q16.16 adds at most 2^-17, so
+// |H_fixed - H_double| <= 2^-16 bits (about 1.5e-5) for windows of up to
+// kFixedMaxTotal (2^24) actions. Above that N * H in Q32.32 could overflow the
+// 64-bit accumulator, so larger totals take the double path instead and are
+// no longer bit-exact across hosts.
+//
+// Select it through the measure policy, e.g.
+// BasicEntropyCalculator<FixedPointShannonEntropy> or
+// BasicSlidingEntropyCalculator<FixedPointShannonEntropy>.
+
+constexpr int kFixedLog2FractionBits = 32;
+constexpr int kFixedEntropyFractionBits = 16;
+constexpr size_t kFixedLog2TableSize = 8193;  // covers [0, 8192]
+constexpr uint64_t kFixedMaxTotal = uint64_t{1} << 24;  // largest bit-exact total
+
+namespace fixed_point_detail {
+
+constexpr std::array<uint64_t, kFixedLog2TableSize> make_fixed_log2_table() {
+    std::array<uint64_t, kFixedLog2TableSize> table{};
+    for (size_t n = 2; n < kFixedLog2TableSize; ++n) {
+        double scaled = constexpr_log2(static_cast<double>(n)) * static_cast<double>(uint64_t{1} << kFixedLog2FractionBits);
+        table[n] = static_cast<uint64_t>(scaled + 0.5);
+    }
+    return table;
+}
+
+inline constexpr std::array<uint64_t, kFixedLog2TableSize> kFixedLog2Table = make_fixed_log2_table();
+
+inline int highest_bit(uint64_t n) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(n);
+#else
+    int bit = 0;
+    while (n >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace fixed_point_detail
+
+// log2(n) in Q32.32; log2(0) is treated as 0
+inline uint64_t fixed_log2_q32(uint64_t n) {
+    using fixed_point_detail::kFixedLog2Table;
+    if (n < kFixedLog2TableSize) return kFixedLog2Table[n];
+
+    // n = m * 2^shift + rest with m in [4096, 8191]
+    int shift = fixed_point_detail::highest_bit(n) - 12;
+    uint64_t m = n >> shift;
+    uint64_t rest = n & ((uint64_t{1} << shift) - 1);
+
+    // Interpolate between L(m) and L(m + 1) on the top 32 bits of the remainder
+    uint64_t step = kFixedLog2Table[m + 1] - kFixedLog2Table[m];
+    uint64_t fraction = shift > 32 ? rest >> (shift - 32) : rest << (32 - shift);
+    uint64_t interpolated = (step * fraction) >> 32;
+
+    return (static_cast<uint64_t>(shift) << kFixedLog2FractionBits) + kFixedLog2Table[m] + interpolated;
+}
+
+// Q16.16 fixed-point value to double; exact, since Q16.16 fits in a double
+constexpr double fixed_q16_to_double(uint32_t value) {
+    return static_cast<double>(value) / static_cast<double>(1u << kFixedEntropyFractionBits);
+}
+
+// Shannon entropy policy with an integer accumulator (see entropy_measures.hpp)
+struct FixedPointShannonEntropy {
+    struct accumulator_type {
+        uint64_t fixed;   // N * H in Q32.32, totals up to kFixedMaxTotal
+        double fallback;  // N * H in bits, larger totals
+    };
+
+    static constexpr accumulator_type initial() { return {0, 0.0}; }
+
+    static void accumulate(accumulator_type& acc, uint32_t count, uint32_t total) {
+        if (count == 0) return;
+        if (total <= kFixedMaxTotal) {
+            acc.fixed += static_cast<uint64_t>(count) * (fixed_log2_q32(total) - fixed_log2_q32(count));
+        } else {
+            acc.fallback += count * std::log2(static_cast<double>(total) / count);
+        }
+    }
+
+    // Entropy in bits as Q16.16, rounded to nearest
+    static uint32_t finalize_fixed(const accumulator_type& acc, uint32_t total) {
+        if (total == 0) return 0;
+        if (total > kFixedMaxTotal) {
+            return static_cast<uint32_t>(std::lround(acc.fallback / total * (1u << kFixedEntropyFractionBits)));
+        }
+        uint64_t entropy_q32 = acc.fixed / total;
+        constexpr int drop = kFixedLog2FractionBits - kFixedEntropyFractionBits;
+        return static_cast<uint32_t>((entropy_q32 + (uint64_t{1} << (drop - 1))) >> drop);
+    }
+
+    static double finalize(const accumulator_type& acc, uint32_t total) {
+        return fixed_q16_to_double(finalize_fixed(acc, total));
+    }
+};
+
+// Raw Q16.16 entropy of a count array, for bit-exact comparisons and storage
+template <size_t N>
+uint32_t fixed_point_entropy_q16(const std::array<uint32_t, N>& counts, uint32_t total) {
+    FixedPointShannonEntropy::accumulator_type acc = FixedPointShannonEntropy::initial();
+    for (uint32_t count : counts) {
+        FixedPointShannonEntropy::accumulate(acc, count, total);
+    }
+    return FixedPointShannonEntropy::finalize_fixed(acc, total);
+}
+
+#endif // FIXED_POINT_ENTROPY_HPP
@@ -0,0 +1,110 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file (POSIX). Pages come straight from
+// the page cache, so readers parse or replay in place without read() copies.
+// open() returns false on any error; an empty file maps to size() == 0.
+class MappedFile {
+public:
+    enum class AccessPattern {
+        NORMAL,
+        SEQUENTIAL,  // aggressive read-ahead, pages dropped behind the reader
+        RANDOM
+    };
+
+    MappedFile() : data_(nullptr), size_(0), open_(false) {}
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , open_(std::exchange(other.open_, false))
+    {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            open_ = std::exchange(other.open_, false);
+        }
+        return *this;
+    }
+
+    bool open(const std::string& path, AccessPattern pattern = AccessPattern::SEQUENTIAL) {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            data_ = static_cast<const uint8_t*>(mapped);
+            advise(pattern);
+        }
+
+        // The mapping keeps the file alive
+        ::close(fd);
+        open_ = true;
+        return true;
+    }
+
+    void close() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    // Re-hint the kernel, e.g. SEQUENTIAL before a full scan
+    void advise(AccessPattern pattern) const {
+        if (data_ == nullptr) return;
+        int advice = pattern == AccessPattern::SEQUENTIAL ? MADV_SEQUENTIAL
+                   : pattern == AccessPattern::RANDOM ? MADV_RANDOM : MADV_NORMAL;
+        ::madvise(const_cast<uint8_t*>(data_), size_, advice);
+        if (pattern == AccessPattern::SEQUENTIAL) {
+            ::madvise(const_cast<uint8_t*>(data_), size_, MADV_WILLNEED);
+        }
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    bool open_;
+};
+
+#endif // MAPPED_FILE_HPP
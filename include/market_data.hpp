@@ -1,9 +1,13 @@
 #ifndef MARKET_DATA_HPP
 #define MARKET_DATA_HPP
 
+#include <array>
+#include <memory_resource>
 #include <vector>
+#include <cstddef>
 #include <cstdint> // specifically added for fixed-width integer types
 #include <string>
+#include <utility>
 
 enum class TraderAction : uint8_t {
     HOLD = 0,
@@ -11,26 +15,150 @@ enum class TraderAction : uint8_t {
     SELL = 2
 };
 
-class MarketData {
+constexpr size_t kTraderActionCount = 3;
+
+// Symbol type for an alphabet of States discrete actions. Finer alphabets
+// (strong-buy .. strong-sell, return buckets) use plain state indices; the
+// three-state alphabet keeps TraderAction.
+template <size_t States>
+struct ActionAlphabet {
+    static_assert(States >= 2 && States <= 256, "alphabet must fit in one byte");
+
+    using symbol_type = uint8_t;
+    static constexpr size_t size = States;
+};
+
+template <>
+struct ActionAlphabet<kTraderActionCount> {
+    using symbol_type = TraderAction;
+    static constexpr size_t size = kTraderActionCount;
+};
+
+// Actions of one market event. Messages usually carry 1-8 actions, so up to
+// kInlineCapacity actions are stored bit-packed inside the object and only
+// larger payloads spill to the heap. Construction, copy and move of an event
+// within the inline capacity never allocate, which keeps the producer, the
+// queue copies and the consumer off the allocator.
+//
+// Spills are allocator-aware (std::pmr): elements of a std::pmr::vector of
+// MarketData place their spill in the vector's resource, e.g. a per-batch arena.
+template <size_t States>
+class BasicMarketData {
     public:
-        MarketData() = default;
-         ~MarketData() = default;
+        using action_type = typename ActionAlphabet<States>::symbol_type;
+        using allocator_type = std::pmr::polymorphic_allocator<action_type>;
+
+        static constexpr size_t kInlineCapacity = 16;
+        // Power-of-two widths so an action never straddles a byte
+        static constexpr size_t kBitsPerAction = States <= 2 ? 1 : States <= 4 ? 2 : States <= 16 ? 4 : 8;
 
-         MarketData(const MarketData&) = default;
-         MarketData& operator=(const MarketData&) = default;
+        BasicMarketData() = default;
+         ~BasicMarketData() = default;
 
-         void add_action(TraderAction action);
+         BasicMarketData(const BasicMarketData&) = default;
+         BasicMarketData& operator=(const BasicMarketData&) = default;
+         // Moves leave the source empty and reusable, spilled or not
+         BasicMarketData(BasicMarketData&& other) noexcept
+             : size_(other.size_), packed_(other.packed_), spilled_(std::move(other.spilled_)) {
+             other.reset_moved_from();
+         }
+         // Not noexcept: when the two spill resources differ, pmr move
+         // assignment copies element by element and can throw
+         BasicMarketData& operator=(BasicMarketData&& other);
 
-         const std::vector<TraderAction>& get_actions() const;
+         explicit BasicMarketData(const allocator_type& allocator)
+             : spilled_(allocator) {}
+         BasicMarketData(const BasicMarketData& other, const allocator_type& allocator)
+             : size_(other.size_), packed_(other.packed_), spilled_(other.spilled_, allocator) {}
+         BasicMarketData(BasicMarketData&& other, const allocator_type& allocator)
+             : size_(other.size_), packed_(other.packed_), spilled_(std::move(other.spilled_), allocator) {
+             other.reset_moved_from();
+         }
+
+         allocator_type get_allocator() const { return spilled_.get_allocator(); }
+
+         void add_action(action_type action);
+
+         size_t size() const { return size_; }
+         bool empty() const { return size_ == 0; }
+         bool is_inline() const { return size_ <= kInlineCapacity; }
+
+         action_type action_at(size_t index) const;
+
+         // Calls fn(action) for each action in order, without materializing a vector
+         template <typename Fn>
+         void for_each_action(Fn&& fn) const;
+
+         // Copies the actions out; allocates, so prefer for_each_action on hot paths
+         std::vector<action_type> get_actions() const;
 
          void clear();
 
     private:
-        std::vector<TraderAction> actions_;
+        static constexpr size_t kActionsPerByte = 8 / kBitsPerAction;
+        static constexpr uint8_t kActionMask = static_cast<uint8_t>((1u << kBitsPerAction) - 1);
+
+        // A moved-from pmr vector is only "valid but unspecified" when the
+        // resources differ, so clear it along with the inline state
+        void reset_moved_from() noexcept {
+            size_ = 0;
+            packed_.fill(0);
+            spilled_.clear();
+        }
+
+        uint32_t size_ = 0;
+        std::array<uint8_t, kInlineCapacity / kActionsPerByte> packed_{};
+        std::pmr::vector<action_type> spilled_;  // holds every action once size_ > kInlineCapacity
+};
+
+#include "market_data.tpp"
+
+using MarketData = BasicMarketData<kTraderActionCount>;
+
+// Non-owning view of actions stored one state index per byte, such as the
+// payload of a wire frame (see wire_format.hpp). It reads straight from the
+// caller's buffer, which must outlive the view.
+class MarketDataView {
+    public:
+        MarketDataView() : data_(nullptr), size_(0) {}
+        MarketDataView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const uint8_t* data() const { return data_; }
+
+        TraderAction action_at(size_t index) const { return static_cast<TraderAction>(data_[index]); }
+
+        template <typename Fn>
+        void for_each_action(Fn&& fn) const {
+            for (size_t i = 0; i < size_; ++i) fn(static_cast<TraderAction>(data_[i]));
+        }
+
+        MarketDataView subview(size_t offset, size_t count) const {
+            offset = offset < size_ ? offset : size_;
+            return MarketDataView(data_ + offset, count < size_ - offset ? count : size_ - offset);
+        }
+
+    private:
+        const uint8_t* data_;
+        size_t size_;
 };
 
+// True if every stride-th byte is a TraderAction; branch-free so the
+// contiguous case vectorizes. Untrusted action bytes must pass this before
+// they index a histogram.
+inline bool valid_action_bytes(const uint8_t* bytes, size_t count, size_t stride = 1) {
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        invalid |= static_cast<uint8_t>(bytes[i * stride] >= kTraderActionCount);
+    }
+    return invalid == 0;
+}
+
+extern template class BasicMarketData<kTraderActionCount>;
+
 double get_spy_price(); 
 TraderAction get_spy_action(double dp);
 
 
-#endif // MARKET_DATA_HPP
\ No newline at end of file
+#endif // MARKET_DATA_HPP
@@ -0,0 +1,68 @@
+// Move the actions out of other, leaving it empty
+template <size_t States>
+BasicMarketData<States>& BasicMarketData<States>::operator=(BasicMarketData&& other) {
+    if (this != &other) {
+        size_ = other.size_;
+        packed_ = other.packed_;
+        spilled_ = std::move(other.spilled_);
+        other.reset_moved_from();
+    }
+    return *this;
+}
+
+// Add a trader action to the stored sequence
+template <size_t States>
+void BasicMarketData<States>::add_action(action_type action) {
+    if (size_ < kInlineCapacity) {
+        size_t byte = size_ / kActionsPerByte;
+        size_t shift = (size_ % kActionsPerByte) * kBitsPerAction;
+        packed_[byte] = static_cast<uint8_t>(packed_[byte] | (static_cast<uint8_t>(action) << shift));
+    } else {
+        if (size_ == kInlineCapacity) {
+            // First spill: move the inline actions to the heap
+            spilled_.reserve(2 * kInlineCapacity);
+            for_each_action([this](action_type a) { spilled_.push_back(a); });
+        }
+        spilled_.push_back(action);
+    }
+    size_++;
+}
+
+// Action at position index (must be < size())
+template <size_t States>
+typename BasicMarketData<States>::action_type BasicMarketData<States>::action_at(size_t index) const {
+    if (!is_inline()) return spilled_[index];
+    size_t shift = (index % kActionsPerByte) * kBitsPerAction;
+    return static_cast<action_type>((packed_[index / kActionsPerByte] >> shift) & kActionMask);
+}
+
+// Visit every action in insertion order
+template <size_t States>
+template <typename Fn>
+void BasicMarketData<States>::for_each_action(Fn&& fn) const {
+    if (!is_inline()) {
+        for (const auto& action : spilled_) fn(action);
+        return;
+    }
+    for (size_t i = 0; i < size_; ++i) {
+        size_t shift = (i % kActionsPerByte) * kBitsPerAction;
+        fn(static_cast<action_type>((packed_[i / kActionsPerByte] >> shift) & kActionMask));
+    }
+}
+
+// Retrieve all recorded trader actions as a new vector
+template <size_t States>
+std::vector<typename BasicMarketData<States>::action_type> BasicMarketData<States>::get_actions() const {
+    std::vector<action_type> actions;
+    actions.reserve(size_);
+    for_each_action([&actions](action_type a) { actions.push_back(a); });
+    return actions;
+}
+
+// Clear all stored trader actions
+template <size_t States>
+void BasicMarketData<States>::clear() {
+    size_ = 0;
+    packed_.fill(0);
+    spilled_.clear();
+}
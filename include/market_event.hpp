@@ -0,0 +1,96 @@
+#ifndef MARKET_EVENT_HPP
+#define MARKET_EVENT_HPP
+
+#include "market_data.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size market event: one action with its timestamp, symbol, price and
+// size. Unlike MarketData it is trivially copyable and exactly 32 bytes
+// (two per cache line, never straddling one), so it can be memcpy'd through
+// ring buffers, shared memory and files as-is.
+//
+// Live events are stamped with market_event_now_ns(), a steady_clock reading,
+// so their ages and intervals are monotonic like the sliding history, the
+// partitioned epochs and the time-window engine. Replayed events
+// (kEventReplay) keep the timestamps of their source, usually wall-clock
+// nanoseconds since the epoch, and are never compared with live time.
+
+enum MarketEventFlags : uint8_t {
+    kEventTrade = 1 << 0,      // print (trade) rather than quote update
+    kEventQuote = 1 << 1,
+    kEventSynthetic = 1 << 2,  // generated locally, e.g. from MarketData
+    kEventReplay = 1 << 3      // read back from storage
+};
+
+// Prices are fixed-point ticks so events compare and hash exactly
+constexpr double kPriceTickSize = 0.0001;
+
+struct alignas(32) MarketEvent {
+    uint64_t timestamp_ns;  // steady_clock ns when live, source time when replayed
+    int64_t price_ticks;    // price / kPriceTickSize
+    uint32_t size;          // shares or contracts
+    uint32_t symbol_id;     // id from SymbolTable
+    TraderAction action;
+    uint8_t flags;          // MarketEventFlags
+    uint8_t reserved[6];    // zero; keeps the layout explicit
+};
+
+static_assert(sizeof(MarketEvent) == 32, "MarketEvent must stay 32 bytes");
+static_assert(std::is_trivially_copyable<MarketEvent>::value, "MarketEvent must be memcpy-safe");
+static_assert(std::is_standard_layout<MarketEvent>::value, "MarketEvent must have a fixed layout");
+
+inline int64_t price_to_ticks(double price) {
+    return static_cast<int64_t>(std::llround(price / kPriceTickSize));
+}
+
+inline double ticks_to_price(int64_t ticks) {
+    return static_cast<double>(ticks) * kPriceTickSize;
+}
+
+// Monotonic timestamp for live events (steady_clock, not wall-clock time)
+inline uint64_t market_event_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline MarketEvent make_market_event(uint64_t timestamp_ns, uint32_t symbol_id, double price,
+                                     uint32_t size, TraderAction action, uint8_t flags = 0) {
+    MarketEvent event{};
+    event.timestamp_ns = timestamp_ns;
+    event.price_ticks = price_to_ticks(price);
+    event.size = size;
+    event.symbol_id = symbol_id;
+    event.action = action;
+    event.flags = flags;
+    return event;
+}
+
+// One event per action of data, all sharing timestamp, symbol, price and size
+inline void append_market_events(const MarketData& data, uint64_t timestamp_ns, uint32_t symbol_id,
+                                 double price, uint32_t size, std::vector<MarketEvent>& out) {
+    MarketEvent event = make_market_event(timestamp_ns, symbol_id, price, size, TraderAction::HOLD, kEventSynthetic);
+    data.for_each_action([&](TraderAction action) {
+        event.action = action;
+        out.push_back(event);
+    });
+}
+
+// The actions of a run of events, in order
+inline MarketData to_market_data(const MarketEvent* events, size_t count) {
+    MarketData data;
+    for (size_t i = 0; i < count; ++i) {
+        data.add_action(events[i].action);
+    }
+    return data;
+}
+
+inline MarketData to_market_data(const std::vector<MarketEvent>& events) {
+    return to_market_data(events.data(), events.size());
+}
+
+#endif // MARKET_EVENT_HPP
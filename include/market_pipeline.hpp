@@ -3,12 +3,21 @@
 
 #include "optimized_queue.hpp"
 #include "sliding_entropy_calculator.hpp"
+#include "permutation_entropy_calculator.hpp"
+#include "partitioned_entropy_calculator.hpp"
+#include "change_point_detector.hpp"
+#include "quantile_discretizer.hpp"
+#include "counting_memory_resource.hpp"
 #include "market_data.hpp"
+#include "market_event.hpp"
 #include <thread>
 #include <atomic>
 #include <vector>
 #include <chrono>
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 
 struct PipelineMetrics {
     std::atomic<uint64_t> total_processed{0};
@@ -19,22 +28,40 @@ struct PipelineMetrics {
     std::atomic<uint64_t> entropy_updates{0};
     std::atomic<double> current_entropy{0.0};
     std::atomic<double> entropy_change_rate{0.0};
+    std::atomic<uint64_t> regime_shifts{0};
+    std::atomic<uint64_t> events_processed{0};
+    std::atomic<double> max_event_age_ns{0.0};  // event timestamp to consumer
 };
 
 class MarketPipeline {
 public:
     using EntropyCallback = std::function<void(double, double)>;
+    using RegimeShiftCallback = std::function<void(const RegimeShiftEvent&)>;
     
+    // Every heap allocation the pipeline makes goes through `upstream`,
+    // wrapped in a counter (see get_allocation_stats)
     MarketPipeline(size_t queue_capacity = 10000,
                    size_t batch_size = 100,
-                   size_t window_size = 100)
-        : queue_(queue_capacity, batch_size)
+                   size_t window_size = 100,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : heap_resource_(upstream)
+        , node_pool_(&heap_resource_)
+        , queue_(queue_capacity, batch_size, &node_pool_)
+        , event_queue_(queue_capacity, batch_size, &node_pool_)
         , entropy_calc_(window_size)
+        , permutation_calc_()
+        , partitioned_calc_(nullptr)
+        , partitioned_entropy_(false)
+        , partition_window_epochs_(8)
+        , partition_publish_interval_(std::chrono::milliseconds(10))
+        , adaptive_discretization_(false)
         , queue_capacity_(queue_capacity)
         , running_(false)
         , producer_threads_()
         , consumer_threads_()
         , entropy_callback_(nullptr)
+        , regime_detector_()
+        , regime_shift_callback_(nullptr)
         , metrics_()
     {}
 
@@ -46,6 +73,11 @@ public:
         if (running_.load()) return;
         
         running_.store(true);
+
+        if (partitioned_entropy_) {
+            partitioned_calc_ = std::make_unique<PartitionedEntropyCalculator>(
+                num_consumers, partition_window_epochs_, partition_publish_interval_);
+        }
         
         for (size_t i = 0; i < num_producers; ++i) {
             producer_threads_.emplace_back(&MarketPipeline::producer_loop, this, i);
@@ -61,6 +93,7 @@ public:
         
         // Notify any waiting consumers to wake up
         queue_.notify_all();
+        event_queue_.notify_all();
         
         for (auto& thread : producer_threads_) {
             if (thread.joinable()) {
@@ -104,56 +137,140 @@ public:
         return success;
     }
 
+    // Fixed-size events travel on their own queue and are consumed alongside
+    // MarketData; live events should be stamped with market_event_now_ns()
+    // (steady_clock), since their timestamps feed the max_event_age_ns metric
+    bool feed_market_event(const MarketEvent& event) {
+        if (event_queue_.push(event)) {
+            metrics_.total_processed.fetch_add(1);
+            return true;
+        }
+        metrics_.queue_full_count.fetch_add(1);
+        return false;
+    }
+
+    // Returns how many events were accepted before the queue filled
+    size_t feed_market_events(const MarketEvent* events, size_t count) {
+        size_t accepted = event_queue_.push_batch(events, count);
+        metrics_.total_processed.fetch_add(accepted);
+        if (accepted < count) metrics_.queue_full_count.fetch_add(1);
+        return accepted;
+    }
+
     void set_entropy_callback(EntropyCallback callback) {
         entropy_callback_ = callback;
     }
 
+    // Called from the consumer thread whenever the change-point detector sees
+    // the entropy series shift to a new regime
+    void set_regime_shift_callback(RegimeShiftCallback callback) {
+        regime_shift_callback_ = callback;
+    }
+
+    void set_regime_detector(const PageHinkleyDetector& detector) {
+        std::lock_guard<std::mutex> lock(regime_mutex_);
+        regime_detector_ = detector;
+    }
+
+    // Allocations that reached the upstream resource. Queue nodes recycle
+    // through a synchronized pool and consumer batches live in per-thread
+    // arenas, so once warm these counts stop growing.
+    AllocationStats get_allocation_stats() const {
+        return heap_resource_.get_stats();
+    }
+
     const PipelineMetrics& get_metrics() const {
         return metrics_;
     }
 
     double get_current_entropy() const {
+        if (partitioned_calc_) return partitioned_calc_->get_current_entropy();
         return entropy_calc_.get_current_entropy();
     }
 
     double get_entropy_change_rate() const {
+        if (partitioned_calc_) return partitioned_calc_->get_entropy_change_rate();
         return entropy_calc_.get_entropy_change_rate();
     }
 
+    // Permutation entropy of the raw producer prices, normalized to [0, 1]
+    double get_permutation_entropy() const {
+        return permutation_calc_.get_normalized_entropy();
+    }
+
     size_t get_queue_size() const {
         return queue_.size();
     }
 
+    size_t get_event_queue_size() const {
+        return event_queue_.size();
+    }
+
+    bool is_running() const {
+        return running_.load();
+    }
+
     bool is_high_entropy() const {
+        if (partitioned_calc_) return partitioned_calc_->is_high_entropy();
         return entropy_calc_.is_high_entropy();
     }
 
     bool is_low_entropy() const {
+        if (partitioned_calc_) return partitioned_calc_->is_low_entropy();
         return entropy_calc_.is_low_entropy();
     }
 
     void set_queue_capacity(size_t capacity) {
         queue_capacity_ = capacity;
         queue_.set_capacity(capacity);
+        event_queue_.set_capacity(capacity);
     }
 
     void set_batch_size(size_t batch_size) {
         queue_.set_batch_size(batch_size);
+        event_queue_.set_batch_size(batch_size);
+    }
+
+    // Give each consumer its own partial histogram instead of sharing the
+    // SlidingEntropyCalculator lock. Entropy is then published per epoch every
+    // publish_interval over the last window_epochs epochs. Takes effect on the
+    // next start().
+    void set_partitioned_entropy(bool enabled,
+                                 size_t window_epochs = 8,
+                                 std::chrono::nanoseconds publish_interval = std::chrono::milliseconds(10)) {
+        if (running_.load()) return;
+        partitioned_entropy_ = enabled;
+        partition_window_epochs_ = window_epochs;
+        partition_publish_interval_ = publish_interval;
+        if (!enabled) partitioned_calc_.reset();
+    }
+
+    // Discretize producer returns by rolling quantiles (QuantileDiscretizer)
+    // instead of get_spy_action's fixed cutoffs. Takes effect on the next start().
+    void set_adaptive_discretization(bool enabled) {
+        if (running_.load()) return;
+        adaptive_discretization_ = enabled;
     }
 
     void set_window_size(size_t window_size) {
         entropy_calc_.set_window_size(window_size);
     }
 
+    void set_adaptation_interval(size_t interval) {
+        entropy_calc_.set_adaptation_interval(interval);
+    }
+
 private:
     void producer_loop(size_t id) {
         static double last_price = 695.49;
+        QuantileDiscretizer discretizer;
 
     while (running_.load()) {
         double spy_price = get_spy_price();
         double dp = (spy_price - last_price) / last_price * 100.0;
         
-        TraderAction action = get_spy_action(dp);
+        TraderAction action = adaptive_discretization_ ? discretizer.discretize(dp) : get_spy_action(dp);
+        permutation_calc_.add_price(spy_price);
 
         MarketData data;
         data.add_action(action);
@@ -164,26 +281,46 @@ private:
         }
     }
 
+    // Each consumer owns a monotonic arena that backs its batches and is reset
+    // after every round, so the steady state never touches the heap
     void consumer_loop(size_t id) {
-        std::vector<MarketData> batch;
+        std::pmr::vector<std::byte> arena_buffer(kConsumerArenaBytes, &heap_resource_);
+        std::pmr::monotonic_buffer_resource arena(arena_buffer.data(), arena_buffer.size(), &heap_resource_);
         
         while (running_.load()) {
-            if (queue_.try_pop_batch(batch)) {
-                process_batch(batch);
-            } else {
+            bool worked = false;
+            {
+                std::pmr::vector<MarketData> batch(&arena);
+                if (queue_.try_pop_batch(batch)) {
+                    process_batch(batch, id);
+                    worked = true;
+                }
+            }
+            {
+                std::pmr::vector<MarketEvent> events(&arena);
+                if (event_queue_.try_pop_batch(events)) {
+                    process_event_batch(events, id);
+                    worked = true;
+                }
+            }
+            arena.release();
+            if (!worked) {
                 std::this_thread::sleep_for(std::chrono::microseconds(10));
             }
         }
     }
 
-    void process_batch(const std::vector<MarketData>& batch) {
+    void process_batch(const std::pmr::vector<MarketData>& batch, size_t consumer_id) {
+        if (partitioned_calc_) {
+            process_batch_partitioned(batch, consumer_id);
+            return;
+        }
+
         for (const auto& data : batch) {
-            const auto& actions = data.get_actions();
-            
-            for (const auto& action : actions) {
+            data.for_each_action([this](TraderAction action) {
                 entropy_calc_.add_action(action);
                 metrics_.entropy_updates.fetch_add(1);
-            }
+            });
         }
         
         double current_entropy = entropy_calc_.get_current_entropy();
@@ -195,6 +332,91 @@ private:
         if (entropy_callback_) {
             entropy_callback_(current_entropy, change_rate);
         }
+
+        detect_regime_shift(current_entropy);
+    }
+
+    void process_event_batch(const std::pmr::vector<MarketEvent>& events, size_t consumer_id) {
+        // Replayed events carry historical timestamps and are left out of the age
+        uint64_t now_ns = market_event_now_ns();
+        uint64_t oldest_ns = now_ns;
+
+        if (partitioned_calc_) {
+            for (const auto& event : events) {
+                partitioned_calc_->add_action(consumer_id, event.action);
+                if (!(event.flags & kEventReplay)) oldest_ns = std::min(oldest_ns, event.timestamp_ns);
+            }
+        } else {
+            for (const auto& event : events) {
+                entropy_calc_.add_action(event.action);
+                if (!(event.flags & kEventReplay)) oldest_ns = std::min(oldest_ns, event.timestamp_ns);
+            }
+        }
+
+        metrics_.entropy_updates.fetch_add(events.size());
+        metrics_.events_processed.fetch_add(events.size());
+
+        // Timestamps from a clock running ahead of ours count as age 0
+        double age = oldest_ns < now_ns ? static_cast<double>(now_ns - oldest_ns) : 0.0;
+        double current_max = metrics_.max_event_age_ns.load();
+        while (age > current_max && !metrics_.max_event_age_ns.compare_exchange_weak(current_max, age)) {
+        }
+
+        if (partitioned_calc_) {
+            publish_partitioned();
+            return;
+        }
+
+        double current_entropy = entropy_calc_.get_current_entropy();
+        double change_rate = entropy_calc_.get_entropy_change_rate();
+        metrics_.current_entropy.store(current_entropy);
+        metrics_.entropy_change_rate.store(change_rate);
+        if (entropy_callback_) {
+            entropy_callback_(current_entropy, change_rate);
+        }
+        detect_regime_shift(current_entropy);
+    }
+
+    // Lock-free hot path: each consumer writes only its own partition
+    void process_batch_partitioned(const std::pmr::vector<MarketData>& batch, size_t consumer_id) {
+        for (const auto& data : batch) {
+            partitioned_calc_->add_actions_batch(consumer_id, data);
+            metrics_.entropy_updates.fetch_add(data.size());
+        }
+
+        publish_partitioned();
+    }
+
+    // Notify only when an epoch actually closed, so callbacks and the
+    // detector never see the same published value twice
+    void publish_partitioned() {
+        if (!partitioned_calc_->maybe_publish()) return;
+
+        double current_entropy = partitioned_calc_->get_current_entropy();
+        double change_rate = partitioned_calc_->get_entropy_change_rate();
+        metrics_.current_entropy.store(current_entropy);
+        metrics_.entropy_change_rate.store(change_rate);
+
+        if (entropy_callback_) {
+            entropy_callback_(current_entropy, change_rate);
+        }
+
+        detect_regime_shift(current_entropy);
+    }
+
+    // One detector update per published entropy value; the event is raised
+    // outside the lock so a slow callback never stalls other consumers
+    void detect_regime_shift(double entropy) {
+        RegimeShiftEvent event;
+        {
+            std::lock_guard<std::mutex> lock(regime_mutex_);
+            if (!regime_detector_.update(entropy, event)) return;
+        }
+
+        metrics_.regime_shifts.fetch_add(1);
+        if (regime_shift_callback_) {
+            regime_shift_callback_(event);
+        }
     }
 
     void update_latency_metrics(uint64_t latency_ns) {
@@ -220,13 +442,27 @@ private:
         }
     }
 
+    static constexpr size_t kConsumerArenaBytes = 64 * 1024;
+
+    CountingMemoryResource heap_resource_;
+    std::pmr::synchronized_pool_resource node_pool_;  // producer -> consumer handoff
     OptimizedQueue<MarketData> queue_;
+    OptimizedQueue<MarketEvent> event_queue_;
     SlidingEntropyCalculator entropy_calc_;
+    PermutationEntropyCalculator permutation_calc_;
+    std::unique_ptr<PartitionedEntropyCalculator> partitioned_calc_;
+    bool partitioned_entropy_;
+    size_t partition_window_epochs_;
+    std::chrono::nanoseconds partition_publish_interval_;
+    bool adaptive_discretization_;
     size_t queue_capacity_;
     std::atomic<bool> running_;
     std::vector<std::thread> producer_threads_;
     std::vector<std::thread> consumer_threads_;
     EntropyCallback entropy_callback_;
+    std::mutex regime_mutex_;
+    PageHinkleyDetector regime_detector_;
+    RegimeShiftCallback regime_shift_callback_;
     PipelineMetrics metrics_;
 };
 
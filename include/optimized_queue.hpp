@@ -1,21 +1,33 @@
 #ifndef OPTIMIZED_QUEUE_HPP
 #define OPTIMIZED_QUEUE_HPP
 
+#include <algorithm>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <cstddef>
 #include <atomic>
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+// Nodes come from a std::pmr::memory_resource (the default resource unless one
+// is given). Producers allocate nodes and consumers free them, so a resource
+// shared by several threads must be synchronized, e.g.
+// std::pmr::synchronized_pool_resource.
 template <typename T>
 class OptimizedQueue {
 public:
-    explicit OptimizedQueue(size_t capacity = 10000, size_t batch_size = 100)
+    explicit OptimizedQueue(size_t capacity = 10000, size_t batch_size = 100,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : capacity_(capacity)
         , batch_size_(batch_size)
-        , head_(std::make_unique<Node>())
+        , resource_(resource)
+        , head_(make_node())
         , tail_(head_.get())
         , size_(0)
         , backpressure_threshold_(capacity * 0.8)
@@ -27,7 +39,7 @@ public:
     OptimizedQueue& operator=(const OptimizedQueue&) = delete;
 
     bool push(const T& data) {
-        auto node = std::make_unique<Node>(data);
+        auto node = make_node(data);
         
         {
             std::lock_guard<std::mutex> lock(tail_mutex_);
@@ -50,6 +62,46 @@ public:
         return true;
     }
 
+    // Push up to count items in one critical section; nodes are built before
+    // taking the lock. Returns how many were accepted before capacity ran out.
+    size_t push_batch(const T* items, size_t count) {
+        if (count == 0) return 0;
+
+        auto first = make_node(items[0]);
+        Node* last = first.get();
+        for (size_t i = 1; i < count; ++i) {
+            last->next = make_node(items[i]);
+            last = last->next.get();
+        }
+
+        size_t accepted;
+        {
+            std::lock_guard<std::mutex> lock(tail_mutex_);
+
+            size_t size = size_.load();
+            size_t room = size < capacity_ ? capacity_ - size : 0;
+            accepted = std::min(count, room);
+            if (accepted == 0) return 0;
+
+            // Detach the nodes that do not fit
+            Node* end = first.get();
+            for (size_t i = 1; i < accepted; ++i) end = end->next.get();
+            end->next.reset();
+
+            tail_->next = std::move(first);
+            tail_ = end;
+            size_.fetch_add(accepted);
+        }
+
+        cv_.notify_all();
+
+        if (size_.load() >= backpressure_threshold_) {
+            backpressure_cv_.notify_all();
+        }
+
+        return accepted;
+    }
+
     bool try_pop(T& data) {
         std::lock_guard<std::mutex> lock(head_mutex_);
         
@@ -69,7 +121,9 @@ public:
         return true;
     }
 
-    bool try_pop_batch(std::vector<T>& batch) {
+    // Batch is any vector-like container, e.g. a std::pmr::vector on an arena
+    template <typename Container>
+    bool try_pop_batch(Container& batch) {
         std::lock_guard<std::mutex> lock(head_mutex_);
         
         if (head_->next == nullptr) {
@@ -138,19 +192,60 @@ public:
     }
 
 private:
+    struct Node;
+
+    // Returns the node's memory to the resource it came from
+    struct NodeDeleter {
+        std::pmr::memory_resource* resource;
+        void operator()(Node* node) const {
+            node->~Node();
+            resource->deallocate(node, sizeof(Node), alignof(Node));
+        }
+    };
+
+    using NodePtr = std::unique_ptr<Node, NodeDeleter>;
+
+    // Allocator-aware payloads (e.g. pmr MarketData) are built with
+    // uses-allocator construction, so anything they spill also comes from the
+    // queue's resource rather than the default one a plain copy would pick
+    template <typename... Args>
+    static T make_data(std::pmr::memory_resource* resource, Args&&... args) {
+        using Allocator = std::pmr::polymorphic_allocator<std::byte>;
+        if constexpr (!std::uses_allocator_v<T, Allocator>) {
+            return T(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible_v<T, std::allocator_arg_t, Allocator, Args...>) {
+            return T(std::allocator_arg, Allocator(resource), std::forward<Args>(args)...);
+        } else {
+            return T(std::forward<Args>(args)..., Allocator(resource));
+        }
+    }
+
     struct Node {
         T data;
-        std::unique_ptr<Node> next;
-        
-        Node() : data(), next(nullptr) {}
-        explicit Node(const T& d) : data(d), next(nullptr) {}
+        NodePtr next;
+
+        template <typename... Args>
+        explicit Node(std::pmr::memory_resource* resource, Args&&... args)
+            : data(make_data(resource, std::forward<Args>(args)...)), next(nullptr, NodeDeleter{nullptr}) {}
     };
 
+    template <typename... Args>
+    NodePtr make_node(Args&&... args) {
+        void* memory = resource_->allocate(sizeof(Node), alignof(Node));
+        try {
+            return NodePtr(new (memory) Node(resource_, std::forward<Args>(args)...), NodeDeleter{resource_});
+        } catch (...) {
+            resource_->deallocate(memory, sizeof(Node), alignof(Node));
+            throw;
+        }
+    }
+
     size_t capacity_;
     size_t batch_size_;
+    std::pmr::memory_resource* resource_;
     std::mutex head_mutex_;
     std::mutex tail_mutex_;
-    std::unique_ptr<Node> head_;
+    NodePtr head_;
     Node* tail_;
     std::atomic<size_t> size_;
     size_t backpressure_threshold_;
@@ -0,0 +1,242 @@
+#ifndef PARTITIONED_ENTROPY_CALCULATOR_HPP
+#define PARTITIONED_ENTROPY_CALCULATOR_HPP
+
+#include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Global (non-per-symbol) entropy fed by several consumer threads without a
+// shared lock. Each consumer owns one partition: a cache-line aligned block of
+// cumulative bin counts that only that thread writes, with relaxed stores and
+// no read-modify-write. Counts are additive, so a combiner merges partitions
+// by summing them.
+//
+// The combiner closes an epoch at a configurable cadence (publish_interval):
+// it snapshots the merged cumulative counts and the window is the difference
+// between the latest snapshot and the one window_epochs earlier. At every epoch
+// boundary the published entropy is exactly what the serial EntropyCalculator
+// returns for the actions added during those epochs, since both run the same
+// Measure over the same integer counts. Consumers call maybe_publish() after a
+// batch; it only try-locks the combiner, so the hot path never waits.
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+class BasicPartitionedEntropyCalculator {
+public:
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+    using Clock = std::chrono::steady_clock;
+    using Counts = std::array<uint64_t, States>;
+
+    explicit BasicPartitionedEntropyCalculator(size_t num_partitions = 1,
+                                               size_t window_epochs = 8,
+                                               std::chrono::nanoseconds publish_interval = std::chrono::milliseconds(10))
+        : partitions_(std::max<size_t>(num_partitions, 1))
+        , window_epochs_(std::max<size_t>(window_epochs, 1))
+        , publish_interval_(publish_interval)
+        , snapshots_(window_epochs_ + 1, Counts{})
+        , latest_snapshot_(0)
+        , epochs_closed_(0)
+        , last_publish_time_(Clock::now())
+        , window_counts_{}
+        , current_entropy_(0.0)
+        , entropy_change_rate_(0.0)
+    {}
+
+    BasicPartitionedEntropyCalculator(const BasicPartitionedEntropyCalculator&) = delete;
+    BasicPartitionedEntropyCalculator& operator=(const BasicPartitionedEntropyCalculator&) = delete;
+
+    // Hot path: only the thread that owns `partition` may call this
+    void add_action(size_t partition, action_type action) {
+        auto& count = partitions_[partition].counts[static_cast<size_t>(action)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void add_actions_batch(size_t partition, const std::vector<action_type>& actions) {
+        Counts local{};
+        for (const auto& action : actions) {
+            local[static_cast<size_t>(action)]++;
+        }
+        add_counts(partition, local);
+    }
+
+    // Rejects the whole view, counting nothing, if any byte is not a
+    // TraderAction; views from WireReader and TickStoreReader always pass
+    bool add_actions_batch(size_t partition, const MarketDataView& view) {
+        static_assert(States >= kTraderActionCount, "view actions are TraderActions");
+        const uint8_t* bytes = view.data();
+        if (!valid_action_bytes(bytes, view.size())) return false;
+
+        Counts local{};
+        for (size_t i = 0; i < view.size(); ++i) {
+            local[bytes[i]]++;
+        }
+        add_counts(partition, local);
+        return true;
+    }
+
+    void add_actions_batch(size_t partition, const BasicMarketData<States>& data) {
+        Counts local{};
+        data.for_each_action([&local](action_type action) { local[static_cast<size_t>(action)]++; });
+        add_counts(partition, local);
+    }
+
+    // Close an epoch if publish_interval has elapsed and no one else is
+    // combining; never blocks. Returns true if an epoch was closed.
+    bool maybe_publish() {
+        std::unique_lock<std::mutex> lock(combiner_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) return false;
+
+        auto now = Clock::now();
+        if (now - last_publish_time_ < publish_interval_) return false;
+
+        close_epoch(now);
+        return true;
+    }
+
+    // Close an epoch now, waiting for a concurrent combiner if necessary
+    void publish() {
+        std::lock_guard<std::mutex> lock(combiner_mutex_);
+        close_epoch(Clock::now());
+    }
+
+    // Entropy as of the last epoch boundary
+    double get_current_entropy() const {
+        return current_entropy_.load(std::memory_order_acquire);
+    }
+
+    // Entropy change per second between the last two epoch boundaries
+    double get_entropy_change_rate() const {
+        return entropy_change_rate_.load(std::memory_order_acquire);
+    }
+
+    bool is_high_entropy() const {
+        return get_current_entropy() > EntropyScale<States>::high_threshold;
+    }
+
+    bool is_low_entropy() const {
+        return get_current_entropy() < EntropyScale<States>::low_threshold;
+    }
+
+    // Merge-on-read: entropy of the open epoch plus the last window_epochs - 1
+    // closed ones, without closing an epoch
+    double get_fresh_entropy() const {
+        std::lock_guard<std::mutex> lock(combiner_mutex_);
+        Counts counts = window_counts_since(merge_partitions(), window_epochs_ - 1);
+        return evaluate(counts);
+    }
+
+    // Window counts as of the last epoch boundary
+    std::array<uint64_t, States> get_action_distribution() const {
+        std::lock_guard<std::mutex> lock(combiner_mutex_);
+        return window_counts_;
+    }
+
+    uint64_t get_epochs_closed() const {
+        std::lock_guard<std::mutex> lock(combiner_mutex_);
+        return epochs_closed_;
+    }
+
+    size_t get_num_partitions() const {
+        return partitions_.size();
+    }
+
+    void set_publish_interval(std::chrono::nanoseconds interval) {
+        std::lock_guard<std::mutex> lock(combiner_mutex_);
+        publish_interval_ = interval;
+    }
+
+private:
+    // One writer per partition; aligned so partitions never share a cache line
+    struct alignas(64) Partition {
+        std::array<std::atomic<uint64_t>, States> counts{};
+    };
+
+    void add_counts(size_t partition, const Counts& local) {
+        auto& counts = partitions_[partition].counts;
+        for (size_t i = 0; i < States; ++i) {
+            if (local[i] > 0) {
+                counts[i].store(counts[i].load(std::memory_order_relaxed) + local[i], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Counts merge_partitions() const {
+        Counts merged{};
+        for (const auto& partition : partitions_) {
+            for (size_t i = 0; i < States; ++i) {
+                merged[i] += partition.counts[i].load(std::memory_order_relaxed);
+            }
+        }
+        return merged;
+    }
+
+    // Cumulative counts minus the snapshot taken `epochs_back` closes before the
+    // latest one. Slots not yet written still hold the zero start snapshot.
+    Counts window_counts_since(const Counts& cumulative, size_t epochs_back) const {
+        size_t ring = snapshots_.size();
+        const Counts& base = snapshots_[(latest_snapshot_ + ring - epochs_back) % ring];
+
+        Counts window{};
+        for (size_t i = 0; i < States; ++i) {
+            window[i] = cumulative[i] - base[i];
+        }
+        return window;
+    }
+
+    void close_epoch(Clock::time_point now) {
+        Counts cumulative = merge_partitions();
+
+        window_counts_ = window_counts_since(cumulative, window_epochs_ - 1);
+        latest_snapshot_ = (latest_snapshot_ + 1) % snapshots_.size();
+        snapshots_[latest_snapshot_] = cumulative;
+        epochs_closed_++;
+
+        double entropy = evaluate(window_counts_);
+        double seconds = std::chrono::duration<double>(now - last_publish_time_).count();
+        double previous = current_entropy_.load(std::memory_order_relaxed);
+        entropy_change_rate_.store(seconds > 0.0 ? (entropy - previous) / seconds : 0.0, std::memory_order_release);
+        last_publish_time_ = now;
+
+        current_entropy_.store(entropy, std::memory_order_release);
+    }
+
+    // Windows that fit in 32 bits go through the same integer path as the
+    // serial calculator. Larger ones (2^32+ actions per window) are evaluated
+    // from the 64-bit counts as weights rather than truncated.
+    static double evaluate(const Counts& counts) {
+        uint64_t total = 0;
+        for (uint64_t count : counts) total += count;
+
+        if (total > UINT32_MAX) {
+            std::array<double, States> weights{};
+            for (size_t i = 0; i < States; ++i) weights[i] = static_cast<double>(counts[i]);
+            return evaluate_weighted_entropy<Measure>(weights);
+        }
+
+        std::array<uint32_t, States> narrowed{};
+        for (size_t i = 0; i < States; ++i) narrowed[i] = static_cast<uint32_t>(counts[i]);
+        return evaluate_entropy<Measure>(narrowed, static_cast<uint32_t>(total));
+    }
+
+    std::vector<Partition> partitions_;
+    size_t window_epochs_;
+
+    // Combiner state
+    mutable std::mutex combiner_mutex_;
+    std::chrono::nanoseconds publish_interval_;
+    std::vector<Counts> snapshots_;
+    size_t latest_snapshot_;
+    uint64_t epochs_closed_;
+    Clock::time_point last_publish_time_;
+    Counts window_counts_;
+    std::atomic<double> current_entropy_;
+    std::atomic<double> entropy_change_rate_;
+};
+
+using PartitionedEntropyCalculator = BasicPartitionedEntropyCalculator<>;
+
+#endif // PARTITIONED_ENTROPY_CALCULATOR_HPP
@@ -0,0 +1,192 @@
+#ifndef PERMUTATION_ENTROPY_CALCULATOR_HPP
+#define PERMUTATION_ENTROPY_CALCULATOR_HPP
+
+#include "entropy_math.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Sliding permutation entropy (Bandt-Pompe) over raw prices.
+// Every run of `dimension` consecutive prices is mapped to its ordinal
+// pattern, encoded as a Lehmer code in [0, dimension!), and counted in a flat
+// array over the last window_size patterns. Unlike get_spy_action there is no
+// threshold: only the relative order of prices matters.
+//
+// The Lehmer digits of the next pattern are the previous digits shifted by one
+// plus a single comparison against the new price, so each price costs O(d)
+// and the price window is never sorted.
+class PermutationEntropyCalculator {
+public:
+    static constexpr size_t kMaxDimension = 7;
+
+    explicit PermutationEntropyCalculator(size_t dimension = 4, size_t window_size = 500)
+        : dimension_(std::min(std::max<size_t>(dimension, 2), kMaxDimension))
+        , window_size_(std::max<size_t>(window_size, 1))
+        , pattern_count_(factorial(dimension_))
+        , prices_{}
+        , digits_{}
+        , prices_seen_(0)
+        , ring_(window_size_)
+        , head_(0)
+        , size_(0)
+        , counts_(pattern_count_, 0)
+        , count_log_sum_(0.0)
+        , updates_since_resync_(0)
+    {}
+
+    void add_price(double price) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        push_price(price);
+    }
+
+    void add_prices_batch(const std::vector<double>& prices) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (double price : prices) {
+            push_price(price);
+        }
+    }
+
+    // Permutation entropy in bits over the pattern window
+    double get_current_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entropy_from_count_sum(count_log_sum_, size_);
+    }
+
+    // Entropy scaled to [0, 1] by the log2(d!) maximum
+    double get_normalized_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entropy_from_count_sum(count_log_sum_, size_) / max_entropy();
+    }
+
+    double get_max_entropy() const {
+        return max_entropy();
+    }
+
+    // Lehmer code of the most recent ordinal pattern
+    uint16_t get_current_pattern() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_ > 0 ? ring_[(head_ + size_ - 1) % window_size_] : 0;
+    }
+
+    std::vector<uint32_t> get_pattern_distribution() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return counts_;
+    }
+
+    size_t get_window_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    size_t get_dimension() const {
+        return dimension_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prices_seen_ = 0;
+        head_ = 0;
+        size_ = 0;
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_log_sum_ = 0.0;
+        updates_since_resync_ = 0;
+    }
+
+private:
+    static constexpr size_t kResyncInterval = size_t{1} << 16;
+
+    static size_t factorial(size_t n) {
+        size_t result = 1;
+        for (size_t i = 2; i <= n; ++i) result *= i;
+        return result;
+    }
+
+    double max_entropy() const {
+        return std::log2(static_cast<double>(pattern_count_));
+    }
+
+    void push_price(double price) {
+        if (prices_seen_ < dimension_) {
+            prices_[prices_seen_++] = price;
+            if (prices_seen_ < dimension_) return;
+
+            // First full pattern: digit i counts later prices below price i
+            for (size_t i = 0; i < dimension_; ++i) {
+                uint8_t digit = 0;
+                for (size_t j = i + 1; j < dimension_; ++j) {
+                    digit += prices_[j] < prices_[i];
+                }
+                digits_[i] = digit;
+            }
+        } else {
+            // Drop the oldest price; every surviving digit only gains the
+            // comparison against the new price
+            for (size_t i = 0; i + 1 < dimension_; ++i) {
+                prices_[i] = prices_[i + 1];
+                digits_[i] = static_cast<uint8_t>(digits_[i + 1] + (price < prices_[i]));
+            }
+            prices_[dimension_ - 1] = price;
+            digits_[dimension_ - 1] = 0;
+        }
+
+        push_pattern(lehmer_code());
+    }
+
+    // Mixed-radix value of the digits: sum digit_i * (d - 1 - i)!
+    uint16_t lehmer_code() const {
+        size_t code = 0;
+        for (size_t i = 0; i < dimension_; ++i) {
+            code = code * (dimension_ - i) + digits_[i];
+        }
+        return static_cast<uint16_t>(code);
+    }
+
+    void push_pattern(uint16_t code) {
+        if (size_ == window_size_) {
+            bump(ring_[head_], false);
+            head_ = (head_ + 1) % window_size_;
+            size_--;
+        }
+
+        ring_[(head_ + size_) % window_size_] = code;
+        size_++;
+        bump(code, true);
+
+        if (++updates_since_resync_ >= kResyncInterval) {
+            count_log_sum_ = 0.0;
+            for (uint32_t count : counts_) {
+                count_log_sum_ += count_log2_count_cached(count);
+            }
+            updates_since_resync_ = 0;
+        }
+    }
+
+    void bump(uint16_t code, bool increment) {
+        uint32_t& count = counts_[code];
+        double before = count_log2_count_cached(count);
+        count = increment ? count + 1 : count - 1;
+        count_log_sum_ += count_log2_count_cached(count) - before;
+    }
+
+    // Configuration parameters
+    size_t dimension_;
+    size_t window_size_;
+    size_t pattern_count_;
+
+    // Thread-safe state
+    mutable std::mutex mutex_;
+    std::array<double, kMaxDimension> prices_;
+    std::array<uint8_t, kMaxDimension> digits_;
+    size_t prices_seen_;
+    std::vector<uint16_t> ring_;
+    size_t head_;
+    size_t size_;
+    std::vector<uint32_t> counts_;
+    double count_log_sum_;
+    size_t updates_since_resync_;
+};
+
+#endif // PERMUTATION_ENTROPY_CALCULATOR_HPP
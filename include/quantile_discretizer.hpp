@@ -0,0 +1,223 @@
+#ifndef QUANTILE_DISCRETIZER_HPP
+#define QUANTILE_DISCRETIZER_HPP
+
+#include "market_data.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Streaming p-quantile by the P-square algorithm (Jain & Chlamtac): five
+// markers whose heights are nudged by piecewise-parabolic interpolation, so
+// each update is O(1) and no samples are stored.
+class P2QuantileEstimator {
+public:
+    explicit P2QuantileEstimator(double p = 0.5)
+        : p_(p)
+    {
+        reset();
+    }
+
+    void add(double x) {
+        if (count_ < 5) {
+            heights_[count_++] = x;
+            if (count_ == 5) std::sort(heights_.begin(), heights_.end());
+            return;
+        }
+        count_++;
+
+        // Cell k such that heights_[k] <= x < heights_[k + 1]
+        size_t k;
+        if (x < heights_[0]) {
+            heights_[0] = x;
+            k = 0;
+        } else if (x >= heights_[4]) {
+            heights_[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= heights_[k + 1]) ++k;
+        }
+
+        for (size_t i = k + 1; i < 5; ++i) positions_[i] += 1.0;
+        for (size_t i = 0; i < 5; ++i) desired_[i] += increments_[i];
+
+        for (size_t i = 1; i < 4; ++i) {
+            double d = desired_[i] - positions_[i];
+            if ((d >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+                (d <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+                double step = d > 0.0 ? 1.0 : -1.0;
+                double candidate = parabolic(i, step);
+                if (heights_[i - 1] < candidate && candidate < heights_[i + 1]) {
+                    heights_[i] = candidate;
+                } else {
+                    heights_[i] = linear(i, step);
+                }
+                positions_[i] += step;
+            }
+        }
+    }
+
+    // Current estimate; exact order statistic while fewer than five samples
+    double get() const {
+        if (count_ >= 5) return heights_[2];
+        if (count_ == 0) return 0.0;
+
+        std::array<double, 5> sorted = heights_;
+        std::sort(sorted.begin(), sorted.begin() + count_);
+        size_t index = static_cast<size_t>(p_ * static_cast<double>(count_ - 1) + 0.5);
+        return sorted[index];
+    }
+
+    size_t count() const { return count_; }
+
+    void reset() {
+        count_ = 0;
+        heights_.fill(0.0);
+        positions_ = {1.0, 2.0, 3.0, 4.0, 5.0};
+        desired_ = {1.0, 1.0 + 2.0 * p_, 1.0 + 4.0 * p_, 3.0 + 2.0 * p_, 5.0};
+        increments_ = {0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+    }
+
+private:
+    double parabolic(size_t i, double step) const {
+        const auto& q = heights_;
+        const auto& n = positions_;
+        return q[i] + step / (n[i + 1] - n[i - 1]) *
+               ((n[i] - n[i - 1] + step) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                (n[i + 1] - n[i] - step) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+    }
+
+    double linear(size_t i, double step) const {
+        size_t j = step > 0.0 ? i + 1 : i - 1;
+        return heights_[i] + step * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+    }
+
+    double p_;
+    size_t count_;
+    std::array<double, 5> heights_;
+    std::array<double, 5> positions_;
+    std::array<double, 5> desired_;
+    std::array<double, 5> increments_;
+};
+
+// Maps returns to SELL / HOLD / BUY by rolling quantiles instead of the fixed
+// +-0.05% cutoffs of get_spy_action(), so the state mix stays stable as
+// volatility changes: returns below the lower quantile are SELL, above the
+// upper quantile BUY, and HOLD in between (ties at the cutoffs are HOLD).
+//
+// "Rolling" is done with two generations of P-square estimators: the active
+// pair supplies the cutoffs while a fresh pair warms up, and every `horizon`
+// returns the fresh pair takes over. Cutoffs therefore always reflect between
+// horizon and 2 * horizon recent returns, at O(1) per update. Until the first
+// estimators have min_samples returns the fixed cutoffs are used.
+//
+// One discretizer per symbol (about 400 bytes); not internally synchronized.
+class QuantileDiscretizer {
+public:
+    explicit QuantileDiscretizer(double lower_quantile = 1.0 / 3.0,
+                                 double upper_quantile = 2.0 / 3.0,
+                                 size_t horizon = 500,
+                                 size_t min_samples = 20)
+        : horizon_(std::max<size_t>(horizon, 5))
+        , min_samples_(std::max<size_t>(min_samples, 1))
+        , generations_{Generation(lower_quantile, upper_quantile), Generation(lower_quantile, upper_quantile)}
+        , active_(0)
+        , since_swap_(0)
+    {}
+
+    // Classify one return (in percent) against the current cutoffs, then learn it
+    TraderAction discretize(double return_pct) {
+        double lower;
+        double upper;
+        get_cutoffs(lower, upper);
+        TraderAction action = classify(return_pct, lower, upper);
+        update(return_pct);
+        return action;
+    }
+
+    // Batch form for the producer hot path: cutoffs are fixed at the start of
+    // the batch, so classification is a branch-free loop the compiler can
+    // vectorize; the O(1) quantile updates follow.
+    void discretize_batch(const double* returns_pct, size_t n, TraderAction* out) {
+        double lower;
+        double upper;
+        get_cutoffs(lower, upper);
+
+        auto* codes = reinterpret_cast<uint8_t*>(out);
+        for (size_t i = 0; i < n; ++i) {
+            double r = returns_pct[i];
+            codes[i] = static_cast<uint8_t>((r > upper) + 2 * (r < lower));
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            update(returns_pct[i]);
+        }
+    }
+
+    // Prices to percent returns, then discretize_batch; previous_price is the
+    // price before prices[0]
+    void discretize_prices(const double* prices, size_t n, double previous_price,
+                           double* returns_scratch, TraderAction* out) {
+        for (size_t i = 0; i < n; ++i) {
+            double prior = i == 0 ? previous_price : prices[i - 1];
+            returns_scratch[i] = (prices[i] - prior) / prior * 100.0;
+        }
+        discretize_batch(returns_scratch, n, out);
+    }
+
+    void get_cutoffs(double& lower, double& upper) const {
+        const Generation& active = generations_[active_];
+        if (active.lower.count() < min_samples_) {
+            lower = -kFixedCutoffPct;
+            upper = kFixedCutoffPct;
+            return;
+        }
+        // The two estimators are independent and can cross on tied data;
+        // clamping keeps BUY and SELL mutually exclusive
+        lower = active.lower.get();
+        upper = std::max(active.upper.get(), lower);
+    }
+
+    void reset() {
+        for (Generation& generation : generations_) generation.reset();
+        active_ = 0;
+        since_swap_ = 0;
+    }
+
+private:
+    static constexpr double kFixedCutoffPct = 0.05;  // get_spy_action's cutoffs
+
+    struct Generation {
+        Generation(double lower_q, double upper_q) : lower(lower_q), upper(upper_q) {}
+        void add(double x) { lower.add(x); upper.add(x); }
+        void reset() { lower.reset(); upper.reset(); }
+        P2QuantileEstimator lower;
+        P2QuantileEstimator upper;
+    };
+
+    static TraderAction classify(double r, double lower, double upper) {
+        return static_cast<TraderAction>((r > upper) + 2 * (r < lower));
+    }
+
+    void update(double return_pct) {
+        generations_[0].add(return_pct);
+        generations_[1].add(return_pct);
+
+        if (++since_swap_ >= horizon_) {
+            // The warming pair has seen exactly `horizon` returns; retire the other
+            size_t retired = active_;
+            active_ ^= 1;
+            generations_[retired].reset();
+            since_swap_ = 0;
+        }
+    }
+
+    size_t horizon_;
+    size_t min_samples_;
+    std::array<Generation, 2> generations_;
+    size_t active_;
+    size_t since_swap_;
+};
+
+#endif // QUANTILE_DISCRETIZER_HPP
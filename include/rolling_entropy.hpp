@@ -0,0 +1,78 @@
+#ifndef ROLLING_ENTROPY_HPP
+#define ROLLING_ENTROPY_HPP
+
+#include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Offline entropy series over a whole action history: out[i] is the entropy of
+// actions[max(0, i - window + 1), i], exactly what a fixed-window
+// BasicSlidingEntropyCalculator<Measure, States, FixedWindowPolicy>(window)
+// reports after its i-th add_action(). Counts slide in O(1) per position and
+// each position is one evaluate_entropy() over them (table lookups for
+// Shannon), so the series costs O(n) instead of O(n * window) and takes no
+// lock. Results are bit-identical to the streaming calculator because both
+// evaluate the same Measure over the same integer counts.
+
+// Positions [begin, end) of the series; counts are primed from the window
+// that precedes begin, so disjoint ranges can run independently
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+void rolling_entropy_range(const typename ActionAlphabet<States>::symbol_type* actions,
+                           size_t window, size_t begin, size_t end, double* out) {
+    window = std::max<size_t>(window, 1);
+    std::array<uint32_t, States> counts{};
+
+    size_t start = begin >= window - 1 ? begin - (window - 1) : 0;
+    for (size_t i = start; i < begin; ++i) {
+        counts[static_cast<size_t>(actions[i])]++;
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        counts[static_cast<size_t>(actions[i])]++;
+        if (i >= start + window) {
+            counts[static_cast<size_t>(actions[i - window])]--;
+        }
+        uint32_t total = static_cast<uint32_t>(std::min(i + 1, window));
+        out[i] = evaluate_entropy<Measure>(counts, total);
+    }
+}
+
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+void rolling_entropy(const typename ActionAlphabet<States>::symbol_type* actions, size_t count,
+                     size_t window, double* out) {
+    rolling_entropy_range<Measure, States>(actions, window, 0, count, out);
+}
+
+// Parallel form: the series is cut into chunks of chunk_size positions, each
+// re-counting the window - 1 actions that overlap the previous chunk
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+void rolling_entropy(const typename ActionAlphabet<States>::symbol_type* actions, size_t count,
+                     size_t window, double* out, ThreadPool& pool, size_t chunk_size = size_t{1} << 16) {
+    // Keep the overlap small relative to the work in each chunk
+    chunk_size = std::max(chunk_size, 4 * window);
+    pool.parallel_for(count, chunk_size, [&](size_t begin, size_t end) {
+        rolling_entropy_range<Measure, States>(actions, window, begin, end, out);
+    });
+}
+
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+std::vector<double> rolling_entropy(const std::vector<typename ActionAlphabet<States>::symbol_type>& actions,
+                                    size_t window) {
+    std::vector<double> series(actions.size());
+    rolling_entropy<Measure, States>(actions.data(), actions.size(), window, series.data());
+    return series;
+}
+
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+std::vector<double> rolling_entropy(const std::vector<typename ActionAlphabet<States>::symbol_type>& actions,
+                                    size_t window, ThreadPool& pool) {
+    std::vector<double> series(actions.size());
+    rolling_entropy<Measure, States>(actions.data(), actions.size(), window, series.data(), pool);
+    return series;
+}
+
+#endif // ROLLING_ENTROPY_HPP
@@ -2,6 +2,9 @@
 #define SLIDING_ENTROPY_CALCULATOR_HPP
 
 #include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include "window_policies.hpp"
+#include "entropy_history.hpp"
 #include <deque>
 #include <array>
 #include <atomic>
@@ -10,26 +13,48 @@
 #include <cmath>
 #include <mutex>
 
-class SlidingEntropyCalculator {
+// Adaptive sliding-window entropy over the action stream. The entropy
+// functional is a compile-time policy from entropy_measures.hpp, the alphabet
+// size is a template parameter and the window-adaptation rule is a policy from
+// window_policies.hpp; Shannon over HOLD/BUY/SELL with the entropy-change rule
+// is what SlidingEntropyCalculator refers to.
+//
+// Entropy history is stamped with steady_clock. Batches record one sample
+// each and single actions record one per action by default.
+template <typename Measure = ShannonEntropy,
+          size_t States = kTraderActionCount,
+          typename WindowPolicy = EntropyChangeWindowPolicy>
+class BasicSlidingEntropyCalculator {
 public:
-    explicit SlidingEntropyCalculator(size_t window_size = 100, 
-                                     size_t min_window = 50,
-                                     size_t max_window = 500)
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kDefaultHistoryInterval = 1;
+
+    explicit BasicSlidingEntropyCalculator(size_t window_size = 100, 
+                                          size_t min_window = 50,
+                                          size_t max_window = 500,
+                                          WindowPolicy window_policy = WindowPolicy())
         : window_size_(window_size)
         , min_window_(min_window)
         , max_window_(max_window)
-        , history_size_(100)
+        , adaptation_interval_(1)
+        , history_interval_(kDefaultHistoryInterval)
+        , window_policy_(window_policy)
+        , action_counts_{}
+        , total_actions_(0)
         , current_entropy_(0.0)
         , previous_entropy_(0.0)
-        , action_counts_{0, 0, 0}
-        , total_actions_(0)
-        , last_update_time_(std::chrono::high_resolution_clock::now())
+        , entropy_at_last_adaptation_(0.0)
+        , actions_since_adaptation_(0)
+        , actions_since_record_(0)
+        , last_update_time_(Clock::now())
     {}
 
-    void add_action(TraderAction action) {
+    void add_action(action_type action) {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        auto now = std::chrono::high_resolution_clock::now();
+        auto now = Clock::now();
         
         if (window_.size() >= window_size_) {
             remove_oldest_action();
@@ -40,26 +65,32 @@ public:
         total_actions_++;
         
         update_entropy_incremental();
+        if (++actions_since_record_ >= history_interval_) {
+            record_history(now);
+        }
         last_update_time_ = now;
         
-        adapt_window_size();
+        adapt_window_size(1);
     }
 
-    void add_actions_batch(const std::vector<TraderAction>& actions) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        for (const auto& action : actions) {
-            if (window_.size() >= window_size_) {
-                remove_oldest_action();
-            }
-            
-            window_.push_back(action);
-            action_counts_[static_cast<size_t>(action)]++;
-            total_actions_++;
-        }
-        
-        update_entropy_incremental();
-        adapt_window_size();
+    void add_actions_batch(const std::vector<action_type>& actions) {
+        add_actions_batch(actions.data(), actions.size());
+    }
+
+    void add_actions_batch(const action_type* actions, size_t count) {
+        add_batch_locked(count, [actions](size_t i) { return actions[i]; });
+    }
+
+    // Straight from a wire buffer (one state index per byte), no copy
+    // Rejects the whole view if any byte is not a TraderAction; views from
+    // WireReader and TickStoreReader are already validated and always pass
+    bool add_actions_batch(const MarketDataView& view) {
+        static_assert(States >= kTraderActionCount, "view actions are TraderActions");
+        const uint8_t* bytes = view.data();
+        if (!valid_action_bytes(bytes, view.size())) return false;
+
+        add_batch_locked(view.size(), [bytes](size_t i) { return static_cast<action_type>(bytes[i]); });
+        return true;
     }
 
     double get_current_entropy() const {
@@ -67,10 +98,22 @@ public:
         return current_entropy_;
     }
 
+    // Evaluate extra measures from the current window's counts in one pass,
+    // e.g. get_entropies<ShannonEntropy, CollisionEntropy, MinEntropy>()
+    template <typename... Measures>
+    std::array<double, sizeof...(Measures)> get_entropies() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return EntropyMeasureSet<Measures...>::evaluate(action_counts_, total_actions_);
+    }
+
+    static constexpr double get_max_entropy() {
+        return EntropyScale<States>::max_entropy;
+    }
+
     double get_entropy_change_rate() const {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        auto now = std::chrono::high_resolution_clock::now();
+        auto now = Clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_time_).count();
         
         if (duration == 0) return 0.0;
@@ -83,24 +126,25 @@ public:
         return window_.size();
     }
 
-    const std::array<uint32_t, 3>& get_action_distribution() const {
+    const std::array<uint32_t, States>& get_action_distribution() const {
         std::lock_guard<std::mutex> lock(mutex_);
         return action_counts_;
     }
 
     bool is_high_entropy() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return current_entropy_ > 1.2;
+        return current_entropy_ > EntropyScale<States>::high_threshold;
     }
 
     bool is_low_entropy() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return current_entropy_ < 0.5;
+        return current_entropy_ < EntropyScale<States>::low_threshold;
     }
 
     bool is_medium_entropy() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return current_entropy_ >= 0.5 && current_entropy_ <= 1.2;
+        return current_entropy_ >= EntropyScale<States>::low_threshold &&
+               current_entropy_ <= EntropyScale<States>::high_threshold;
     }
 
     void set_window_size(size_t size) {
@@ -111,38 +155,85 @@ public:
         }
     }
 
+    // Evaluate the window policy every `interval` actions instead of every one
+    void set_adaptation_interval(size_t interval) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        adaptation_interval_ = std::max<size_t>(interval, 1);
+    }
+
+    // Opt-in sampling: record single-action entropy to the history only every
+    // `interval` actions, keeping the per-event path off the history rings.
+    // The raw tier and its rollups then see samples, so their min/max can
+    // miss extremes between samples.
+    void set_history_interval(size_t interval) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        history_interval_ = std::max<size_t>(interval, 1);
+    }
+
+    size_t get_target_window_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return window_size_;
+    }
+
     void clear() {
         std::lock_guard<std::mutex> lock(mutex_);
         window_.clear();
         entropy_history_.clear();
-        action_counts_ = {0, 0, 0};
+        action_counts_.fill(0);
         total_actions_ = 0;
         current_entropy_ = 0.0;
         previous_entropy_ = 0.0;
+        entropy_at_last_adaptation_ = 0.0;
+        actions_since_adaptation_ = 0;
+        actions_since_record_ = 0;
     }
 
-    std::vector<TraderAction> get_window_actions() const {
+    std::vector<action_type> get_window_actions() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return std::vector<TraderAction>(window_.begin(), window_.end());
+        return std::vector<action_type>(window_.begin(), window_.end());
     }
 
+    // Most recent n recorded entropy values, newest first. Reads the history
+    // rings directly and never takes the calculator lock.
     std::vector<double> get_entropy_history(size_t n =10) const {
+        return entropy_history_.get_recent(n);
+    }
+
+    // Entropy history over [from, to] at raw, 1s, 1m or 1h resolution, oldest
+    // first; timestamps are steady_clock. Lock-free like the above.
+    std::vector<EntropyRollup> get_entropy_history(HistoryResolution resolution,
+                                                   Clock::time_point from,
+                                                   Clock::time_point to) const {
+        return entropy_history_.query(resolution, to_timestamp_ns(from), to_timestamp_ns(to));
+    }
+
+private:
+    template <typename ActionAt>
+    void add_batch_locked(size_t count, ActionAt action_at) {
         std::lock_guard<std::mutex> lock(mutex_);
-        std::vector<double> history;
-        history.reserve(std::min(n, entropy_history_.size()));
-        auto it = entropy_history_.rbegin();
-        for (size_t i = 0; i < n && it != entropy_history_.rend(); ++i, ++it) {
-            history.push_back(*it);
+        
+        for (size_t i = 0; i < count; ++i) {
+            action_type action = action_at(i);
+            if (window_.size() >= window_size_) {
+                remove_oldest_action();
+            }
+            
+            window_.push_back(action);
+            action_counts_[static_cast<size_t>(action)]++;
+            total_actions_++;
         }
-        return history;
+        
+        auto now = Clock::now();
+        update_entropy_incremental();
+        record_history(now);
+        adapt_window_size(count);
     }
 
-private:
     // Remove the oldest action from the sliding window
     void remove_oldest_action() {
         if (window_.empty()) return;
         
-        TraderAction oldest = window_.front();
+        action_type oldest = window_.front();
         window_.pop_front();
         
         action_counts_[static_cast<size_t>(oldest)]--;
@@ -152,33 +243,30 @@ private:
     // Update entropy calculation based on the current action distribution
     void update_entropy_incremental() {
         previous_entropy_ = current_entropy_;
-        
-        if (total_actions_ == 0) {
-            current_entropy_ = 0.0;
-            update_entropy_history(0.0);
-            return;
-        }
-        
-        double entropy = 0.0;
-        for (size_t i = 0; i < 3; ++i) {
-            if (action_counts_[i] > 0) {
-                double p = static_cast<double>(action_counts_[i]) / total_actions_;
-                entropy -= p * std::log2(p);
-            }
-        }
-        
-        current_entropy_ = entropy;
-        update_entropy_history(entropy);
+        current_entropy_ = evaluate_entropy<Measure>(action_counts_, total_actions_);
     }
 
-    // Adapt window size based on the entropy change rate
-    void adapt_window_size() {
-        double entropy_change = std::abs(current_entropy_ - previous_entropy_);
-        
-        if (entropy_change > 0.1 && window_.size() < max_window_) {
-            window_size_ = std::min(window_.size() + 10, max_window_);
-        } else if (entropy_change < 0.01 && window_.size() > min_window_) {
-            window_size_ = std::max(window_.size() - 5, min_window_);
+    void record_history(Clock::time_point now) {
+        entropy_history_.record(to_timestamp_ns(now), current_entropy_);
+        actions_since_record_ = 0;
+    }
+
+    // Adapt window size through the policy once adaptation_interval_ actions
+    // have accumulated; compiled out for non-adaptive policies
+    void adapt_window_size(size_t added) {
+        if constexpr (WindowPolicy::kAdaptive) {
+            actions_since_adaptation_ += added;
+            if (actions_since_adaptation_ < adaptation_interval_) return;
+
+            WindowAdaptationContext ctx{current_entropy_, entropy_at_last_adaptation_,
+                                        window_.size(), window_size_, min_window_, max_window_,
+                                        actions_since_adaptation_};
+            window_size_ = window_policy_.next_window_size(ctx);
+
+            entropy_at_last_adaptation_ = current_entropy_;
+            actions_since_adaptation_ = 0;
+        } else {
+            (void)added;
         }
     }
 
@@ -189,28 +277,33 @@ private:
         }
     }
 
-    void update_entropy_history(double entropy){
-        entropy_history_.push_back(entropy);
-        if (entropy_history_.size() > history_size_) {
-            entropy_history_.pop_front();
-        }
+    static uint64_t to_timestamp_ns(Clock::time_point time) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            time.time_since_epoch()).count());
     }
 
     // Configuration parameters
     size_t window_size_;
     size_t min_window_;
     size_t max_window_;
-    size_t history_size_;
+    size_t adaptation_interval_;
+    size_t history_interval_;
+    WindowPolicy window_policy_;
     
     // Thread-safe state
     mutable std::mutex mutex_;
-    std::deque<TraderAction> window_;
-    std::deque<double> entropy_history_;
-    std::array<uint32_t, 3> action_counts_;
+    std::deque<action_type> window_;
+    EntropyHistory entropy_history_;  // single writer (under mutex_), lock-free readers
+    std::array<uint32_t, States> action_counts_;
     uint32_t total_actions_;
     double current_entropy_;
     double previous_entropy_;
-    std::chrono::high_resolution_clock::time_point last_update_time_;
+    double entropy_at_last_adaptation_;
+    size_t actions_since_adaptation_;
+    size_t actions_since_record_;
+    Clock::time_point last_update_time_;
 };
 
+using SlidingEntropyCalculator = BasicSlidingEntropyCalculator<>;
+
 #endif // SLIDING_ENTROPY_CALCULATOR_HPP
@@ -0,0 +1,56 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Interns ticker symbols to dense ids (0, 1, 2, ...) so per-symbol state can
+// live in flat arrays indexed by id instead of maps keyed by string.
+class SymbolTable {
+public:
+    static constexpr uint32_t kInvalidId = UINT32_MAX;
+
+    SymbolTable() = default;
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // Id for symbol, assigning the next free id on first sight
+    uint32_t intern(const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) return it->second;
+
+        uint32_t id = static_cast<uint32_t>(names_.size());
+        names_.push_back(symbol);
+        ids_.emplace(symbol, id);
+        return id;
+    }
+
+    // Id for an already interned symbol, kInvalidId otherwise
+    uint32_t find(const std::string& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(symbol);
+        return it != ids_.end() ? it->second : kInvalidId;
+    }
+
+    std::string name(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : std::string();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return names_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::string> names_;
+};
+
+#endif // SYMBOL_TABLE_HPP
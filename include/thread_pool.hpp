@@ -0,0 +1,137 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool for data-parallel loops. parallel_for() splits
+// [0, count) into chunks of chunk_size and workers (plus the calling thread)
+// claim chunks from a shared atomic cursor, so uneven chunks balance
+// themselves without a task queue. One loop runs at a time; concurrent
+// callers are serialized.
+class ThreadPool {
+public:
+    // num_threads counts the calling thread, so a pool of 1 runs inline
+    explicit ThreadPool(size_t num_threads = std::max(1u, std::thread::hardware_concurrency()))
+        : generation_(0)
+        , pending_workers_(0)
+        , stop_(false)
+        , count_(0)
+        , chunk_size_(1)
+        , next_(0)
+    {
+        size_t workers = std::max<size_t>(num_threads, 1) - 1;
+        workers_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const {
+        return workers_.size() + 1;
+    }
+
+    // Calls fn(begin, end) for every chunk of [0, count) and returns when all
+    // chunks are done. The first exception thrown by fn is rethrown here.
+    template <typename Fn>
+    void parallel_for(size_t count, size_t chunk_size, Fn&& fn) {
+        if (count == 0) return;
+        chunk_size = std::max<size_t>(chunk_size, 1);
+
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+        if (workers_.empty() || count <= chunk_size) {
+            fn(size_t{0}, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = std::ref(fn);
+            count_ = count;
+            chunk_size_ = chunk_size;
+            next_.store(0, std::memory_order_relaxed);
+            error_ = nullptr;
+            pending_workers_ = workers_.size();
+            generation_++;
+        }
+        work_cv_.notify_all();
+
+        run_chunks();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_workers_ == 0; });
+        job_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    void worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+
+            run_chunks();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_workers_ == 0) done_cv_.notify_one();
+        }
+    }
+
+    void run_chunks() {
+        for (;;) {
+            size_t begin = next_.fetch_add(chunk_size_, std::memory_order_relaxed);
+            if (begin >= count_) return;
+            size_t end = std::min(begin + chunk_size_, count_);
+            try {
+                job_(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_;
+    size_t pending_workers_;
+    bool stop_;
+
+    // Current loop; written under mutex_ before generation_ is bumped
+    std::function<void(size_t, size_t)> job_;
+    size_t count_;
+    size_t chunk_size_;
+    std::atomic<size_t> next_;
+    std::exception_ptr error_;
+};
+
+#endif // THREAD_POOL_HPP
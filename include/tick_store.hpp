@@ -0,0 +1,148 @@
+#ifndef TICK_STORE_HPP
+#define TICK_STORE_HPP
+
+#include "market_data.hpp"
+#include "market_event.hpp"
+#include "mapped_file.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Columnar on-disk tick store. A store is a directory with one flat file per
+// column plus a sparse time index and a small metadata file:
+//
+//   timestamp.col  u64 per row (non-decreasing)
+//   symbol.col     u32 per row
+//   price.col      i64 per row (ticks of kPriceTickSize)
+//   size.col       u32 per row
+//   action.col     u8 per row (TraderAction)
+//   time.idx       {u64 timestamp, u64 row} for every index_stride-th row
+//   meta.bin       magic, version, row count, index stride, flags
+//
+// Columns are native little-endian arrays with no per-file header, so a
+// reader maps them and uses them as typed arrays in place. Scanning one
+// column touches only that column's pages, and replay streams at page-cache
+// speed. Writer and reader report failures by returning false.
+//
+// With TickStoreCompression::COLUMN_CODEC the timestamp, price and action
+// columns are written as timestamp.cz, price.cz and action.cz instead: one
+// chunk per writer flush (u32 rows, u32 bytes, payload) encoded with the
+// delta and action codecs from column_codec.hpp. Compressed stores are not
+// read lazily: open() decodes those three columns in full into heap vectors
+// (17 bytes per row) and only the symbol and size columns stay mapped, so
+// timestamps(), price_ticks(), actions() and action_view() point into those
+// vectors. Use the raw layout for zero-copy replay of stores too large to hold
+// in memory; the compressed one is for archives.
+
+constexpr uint32_t kTickStoreMagic = 0x53544551;  // "QETS" in little-endian
+constexpr uint32_t kTickStoreVersion = 2;  // 2 adds compressed columns
+
+enum class TickStoreCompression : uint32_t {
+    NONE = 0,
+    COLUMN_CODEC = 1
+};
+
+struct TickIndexEntry {
+    uint64_t timestamp_ns;
+    uint64_t row;
+};
+
+// Streaming writer: rows are buffered per column and flushed in blocks, and
+// close() writes the metadata that makes the store readable
+class TickStoreWriter {
+public:
+    explicit TickStoreWriter(size_t index_stride = 4096, size_t buffer_rows = 65536,
+                             TickStoreCompression compression = TickStoreCompression::NONE);
+    ~TickStoreWriter();
+
+    TickStoreWriter(const TickStoreWriter&) = delete;
+    TickStoreWriter& operator=(const TickStoreWriter&) = delete;
+
+    // Creates the directory if needed and truncates any existing store
+    bool open(const std::string& directory);
+
+    // Timestamps must be non-decreasing; false on a violation or I/O error
+    bool append(const MarketEvent& event);
+    bool append(const MarketEvent* events, size_t count);
+
+    // Flushes all columns and writes meta.bin
+    bool close();
+
+    uint64_t rows() const { return rows_; }
+    bool is_open() const { return open_; }
+
+private:
+    enum Column { TIMESTAMP = 0, SYMBOL, PRICE, SIZE, ACTION, INDEX, kFileCount };
+
+    bool flush();
+    bool write_meta();
+
+    std::string directory_;
+    size_t index_stride_;
+    size_t buffer_rows_;
+    TickStoreCompression compression_;
+
+    std::array<std::FILE*, kFileCount> files_;
+    std::vector<uint64_t> timestamps_;
+    std::vector<uint32_t> symbols_;
+    std::vector<int64_t> prices_;
+    std::vector<uint32_t> sizes_;
+    std::vector<uint8_t> actions_;
+    std::vector<TickIndexEntry> index_;
+    std::vector<uint8_t> encoded_;
+
+    uint64_t rows_;
+    uint64_t last_timestamp_;
+    bool open_;
+    bool failed_;
+};
+
+// Memory-mapped reader with sequential read-ahead hints on every column.
+// Reads both raw stores (zero-copy) and compressed ones (decoded at open()).
+class TickStoreReader {
+public:
+    TickStoreReader();
+
+    bool open(const std::string& directory);
+    void close();
+
+    uint64_t rows() const { return rows_; }
+    bool is_open() const { return open_; }
+    TickStoreCompression compression() const { return compression_; }
+
+    const uint64_t* timestamps() const { return reinterpret_cast<const uint64_t*>(column_data_[0]); }
+    const uint32_t* symbol_ids() const { return reinterpret_cast<const uint32_t*>(column_data_[1]); }
+    const int64_t* price_ticks() const { return reinterpret_cast<const int64_t*>(column_data_[2]); }
+    const uint32_t* sizes() const { return reinterpret_cast<const uint32_t*>(column_data_[3]); }
+    const uint8_t* actions() const { return column_data_[4]; }
+
+    // Actions of rows [begin, end) as a zero-copy view
+    MarketDataView action_view(uint64_t begin, uint64_t end) const;
+
+    MarketEvent event_at(uint64_t row) const;
+
+    // Gathers up to count rows starting at row into out; returns rows read
+    size_t read_events(uint64_t row, size_t count, MarketEvent* out) const;
+
+    // First row with timestamp >= timestamp_ns (rows() if none): a binary
+    // search of the sparse index, then of one index stride of timestamps
+    uint64_t lower_bound(uint64_t timestamp_ns) const;
+
+private:
+    bool decode_columns(const std::string& directory, uint64_t rows);
+
+    std::array<MappedFile, 5> columns_;
+    std::array<const uint8_t*, 5> column_data_;
+    std::vector<int64_t> decoded_timestamps_;
+    std::vector<int64_t> decoded_prices_;
+    std::vector<uint8_t> decoded_actions_;
+    MappedFile index_;
+    uint64_t rows_;
+    uint32_t index_stride_;
+    TickStoreCompression compression_;
+    bool open_;
+};
+
+#endif // TICK_STORE_HPP
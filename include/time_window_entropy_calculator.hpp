@@ -0,0 +1,218 @@
+#ifndef TIME_WINDOW_ENTROPY_CALCULATOR_HPP
+#define TIME_WINDOW_ENTROPY_CALCULATOR_HPP
+
+#include "market_data.hpp"
+#include "entropy_measures.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Sliding entropy over the last N nanoseconds instead of the last N events.
+// Actions carry a timestamp (event time or wall-clock) and expire once they are
+// older than the configured duration. Expiry pops from the front of a
+// timestamped ring, so eviction is amortized O(1) per action. Measure and
+// alphabet are template parameters as in BasicSlidingEntropyCalculator.
+template <typename Measure = ShannonEntropy, size_t States = kTraderActionCount>
+class BasicTimeWindowEntropyCalculator {
+public:
+    using Clock = std::chrono::steady_clock;
+    using action_type = typename ActionAlphabet<States>::symbol_type;
+
+    explicit BasicTimeWindowEntropyCalculator(std::chrono::nanoseconds window_duration = std::chrono::milliseconds(1000),
+                                         size_t initial_capacity = 256)
+        : window_duration_ns_(static_cast<uint64_t>(window_duration.count()))
+        , ring_(initial_capacity > 0 ? initial_capacity : 1)
+        , head_(0)
+        , size_(0)
+        , action_counts_{}
+        , total_actions_(0)
+        , current_entropy_(0.0)
+        , latest_timestamp_ns_(0)
+    {}
+
+    // Add an action stamped with the current steady clock time
+    void add_action(action_type action) {
+        add_action(action, now_ns());
+    }
+
+    // Add an action stamped with an explicit event time. Timestamps are
+    // expected to be non-decreasing; late events are clamped to the latest seen.
+    void add_action(action_type action, uint64_t timestamp_ns) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (timestamp_ns < latest_timestamp_ns_) {
+            timestamp_ns = latest_timestamp_ns_;
+        }
+        latest_timestamp_ns_ = timestamp_ns;
+
+        expire_before(timestamp_ns);
+        push_back(TimedAction{timestamp_ns, action});
+        action_counts_[static_cast<size_t>(action)]++;
+        total_actions_++;
+
+        update_entropy();
+    }
+
+    void add_actions_batch(const std::vector<action_type>& actions, uint64_t timestamp_ns) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (timestamp_ns < latest_timestamp_ns_) {
+            timestamp_ns = latest_timestamp_ns_;
+        }
+        latest_timestamp_ns_ = timestamp_ns;
+
+        expire_before(timestamp_ns);
+        for (const auto& action : actions) {
+            push_back(TimedAction{timestamp_ns, action});
+            action_counts_[static_cast<size_t>(action)]++;
+            total_actions_++;
+        }
+
+        update_entropy();
+    }
+
+    // Expire actions relative to a clock reading without adding anything, so
+    // entropy decays to the quiet-market value when the feed goes silent.
+    void advance_time(uint64_t now_timestamp_ns) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (now_timestamp_ns < latest_timestamp_ns_) return;
+        latest_timestamp_ns_ = now_timestamp_ns;
+
+        if (expire_before(now_timestamp_ns)) {
+            update_entropy();
+        }
+    }
+
+    void advance_time() {
+        advance_time(now_ns());
+    }
+
+    double get_current_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_entropy_;
+    }
+
+    size_t get_window_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    std::chrono::nanoseconds get_window_duration() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::chrono::nanoseconds(window_duration_ns_);
+    }
+
+    std::array<uint32_t, States> get_action_distribution() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return action_counts_;
+    }
+
+    bool is_high_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_entropy_ > EntropyScale<States>::high_threshold;
+    }
+
+    bool is_low_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_entropy_ < EntropyScale<States>::low_threshold;
+    }
+
+    bool is_medium_entropy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_entropy_ >= EntropyScale<States>::low_threshold &&
+               current_entropy_ <= EntropyScale<States>::high_threshold;
+    }
+
+    // Shrinking the duration expires immediately against the latest timestamp
+    void set_window_duration(std::chrono::nanoseconds duration) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        window_duration_ns_ = static_cast<uint64_t>(duration.count());
+        if (expire_before(latest_timestamp_ns_)) {
+            update_entropy();
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = 0;
+        size_ = 0;
+        action_counts_.fill(0);
+        total_actions_ = 0;
+        current_entropy_ = 0.0;
+        latest_timestamp_ns_ = 0;
+    }
+
+    std::vector<action_type> get_window_actions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<action_type> actions;
+        actions.reserve(size_);
+        for (size_t i = 0; i < size_; ++i) {
+            actions.push_back(ring_[(head_ + i) % ring_.size()].action);
+        }
+        return actions;
+    }
+
+private:
+    struct TimedAction {
+        uint64_t timestamp_ns;
+        action_type action;
+    };
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count());
+    }
+
+    // Pop every action older than now - duration; returns true if any expired
+    bool expire_before(uint64_t now_timestamp_ns) {
+        if (now_timestamp_ns < window_duration_ns_) return false;
+        uint64_t cutoff = now_timestamp_ns - window_duration_ns_;
+
+        bool expired = false;
+        while (size_ > 0 && ring_[head_].timestamp_ns <= cutoff) {
+            action_counts_[static_cast<size_t>(ring_[head_].action)]--;
+            total_actions_--;
+            head_ = (head_ + 1) % ring_.size();
+            size_--;
+            expired = true;
+        }
+        return expired;
+    }
+
+    // Append to the ring, doubling capacity when a burst outgrows it
+    void push_back(const TimedAction& entry) {
+        if (size_ == ring_.size()) {
+            std::vector<TimedAction> grown(ring_.size() * 2);
+            for (size_t i = 0; i < size_; ++i) {
+                grown[i] = ring_[(head_ + i) % ring_.size()];
+            }
+            ring_.swap(grown);
+            head_ = 0;
+        }
+        ring_[(head_ + size_) % ring_.size()] = entry;
+        size_++;
+    }
+
+    // Recompute entropy from the bin counts; O(K) in the number of bins
+    void update_entropy() {
+        current_entropy_ = evaluate_entropy<Measure>(action_counts_, total_actions_);
+    }
+
+    uint64_t window_duration_ns_;
+
+    mutable std::mutex mutex_;
+    std::vector<TimedAction> ring_;
+    size_t head_;
+    size_t size_;
+    std::array<uint32_t, States> action_counts_;
+    uint32_t total_actions_;
+    double current_entropy_;
+    uint64_t latest_timestamp_ns_;
+};
+
+using TimeWindowEntropyCalculator = BasicTimeWindowEntropyCalculator<>;
+
+#endif // TIME_WINDOW_ENTROPY_CALCULATOR_HPP
@@ -0,0 +1,182 @@
+#ifndef TRANSFER_ENTROPY_CALCULATOR_HPP
+#define TRANSFER_ENTROPY_CALCULATOR_HPP
+
+#include "market_data.hpp"
+#include "entropy_math.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Streaming conditional and transfer entropy between two action streams,
+// e.g. SPY (X) leading a sector ETF (Y). Observations arrive as aligned pairs
+// (X_t, Y_t); each new pair completes the triple (X_t, Y_t, Y_{t+1}) for the
+// previous step. Sliding joint counts of the last window_size triples live in
+// a 27-cell array alongside their 9- and 3-cell marginals, and every marginal
+// keeps S = sum(c log2 c) incrementally, so an update is O(1):
+//
+//   H(Y|X)  = H(X_t, Y_t) - H(X_t)
+//   TE(X->Y) = H(Y_{t+1} | Y_t) - H(Y_{t+1} | Y_t, X_t)
+//           = H(X_t, Y_t) + H(Y_t, Y_{t+1}) - H(Y_t) - H(X_t, Y_t, Y_{t+1})
+//
+// The ring is allocated once at construction and no update allocates. Not
+// internally synchronized, so one consumer thread can own many pairs cheaply.
+class TransferEntropyCalculator {
+public:
+    explicit TransferEntropyCalculator(size_t window_size = 500)
+        : window_size_(std::max<size_t>(window_size, 1))
+        , ring_(window_size_)
+        , head_(0)
+        , size_(0)
+        , has_previous_(false)
+        , previous_x_(0)
+        , previous_y_(0)
+        , joint_counts_{}
+        , xy_counts_{}
+        , yy_counts_{}
+        , x_counts_{}
+        , y_counts_{}
+        , count_log_sums_{}
+        , updates_since_resync_(0)
+    {}
+
+    // Add the next aligned observation of both streams
+    void add_pair(TraderAction x, TraderAction y) {
+        uint8_t x_state = static_cast<uint8_t>(x);
+        uint8_t y_state = static_cast<uint8_t>(y);
+
+        if (has_previous_) {
+            if (size_ == window_size_) {
+                remove_triple(ring_[head_]);
+                head_ = (head_ + 1) % window_size_;
+                size_--;
+            }
+
+            uint8_t code = static_cast<uint8_t>((previous_x_ * 3 + previous_y_) * 3 + y_state);
+            ring_[(head_ + size_) % window_size_] = code;
+            size_++;
+            add_triple(code);
+
+            if (++updates_since_resync_ >= kResyncInterval) {
+                resync_count_log_sums();
+            }
+        }
+
+        previous_x_ = x_state;
+        previous_y_ = y_state;
+        has_previous_ = true;
+    }
+
+    // Conditional entropy H(Y_t | X_t) in bits over the window
+    double get_conditional_entropy() const {
+        double conditional = entropy(kXY) - entropy(kX);
+        return conditional > 0.0 ? conditional : 0.0;
+    }
+
+    // Transfer entropy X -> Y in bits: information X_t adds about Y_{t+1}
+    // beyond what Y_t already carries
+    double get_transfer_entropy() const {
+        double te = entropy(kXY) + entropy(kYY) - entropy(kY) - entropy(kJoint);
+        return te > 0.0 ? te : 0.0;
+    }
+
+    // Marginal entropy H(Y_t) in bits over the window
+    double get_target_entropy() const {
+        return entropy(kY);
+    }
+
+    // Count of (X_t, Y_t, Y_{t+1}) in the window
+    uint32_t get_joint_count(TraderAction x, TraderAction y, TraderAction y_next) const {
+        size_t code = (static_cast<size_t>(x) * 3 + static_cast<size_t>(y)) * 3 + static_cast<size_t>(y_next);
+        return joint_counts_[code];
+    }
+
+    const std::array<uint32_t, 27>& get_joint_distribution() const {
+        return joint_counts_;
+    }
+
+    size_t get_window_size() const {
+        return size_;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+        has_previous_ = false;
+        joint_counts_.fill(0);
+        xy_counts_.fill(0);
+        yy_counts_.fill(0);
+        x_counts_.fill(0);
+        y_counts_.fill(0);
+        count_log_sums_.fill(0.0);
+        updates_since_resync_ = 0;
+    }
+
+private:
+    // Index of each distribution's S in count_log_sums_
+    enum Marginal : size_t { kJoint = 0, kXY, kYY, kX, kY, kMarginals };
+
+    static constexpr size_t kResyncInterval = size_t{1} << 16;
+
+    static void bump(uint32_t& count, double& count_log_sum, bool increment) {
+        double before = count_log2_count_cached(count);
+        count = increment ? count + 1 : count - 1;
+        count_log_sum += count_log2_count_cached(count) - before;
+    }
+
+    void update_triple(uint8_t code, bool increment) {
+        size_t x = code / 9;
+        size_t y = (code / 3) % 3;
+        size_t y_next = code % 3;
+
+        bump(joint_counts_[code], count_log_sums_[kJoint], increment);
+        bump(xy_counts_[x * 3 + y], count_log_sums_[kXY], increment);
+        bump(yy_counts_[y * 3 + y_next], count_log_sums_[kYY], increment);
+        bump(x_counts_[x], count_log_sums_[kX], increment);
+        bump(y_counts_[y], count_log_sums_[kY], increment);
+    }
+
+    void add_triple(uint8_t code) { update_triple(code, true); }
+    void remove_triple(uint8_t code) { update_triple(code, false); }
+
+    template <size_t N>
+    static double count_log_sum(const std::array<uint32_t, N>& counts) {
+        double sum = 0.0;
+        for (uint32_t count : counts) {
+            sum += count_log2_count_cached(count);
+        }
+        return sum;
+    }
+
+    void resync_count_log_sums() {
+        count_log_sums_[kJoint] = count_log_sum(joint_counts_);
+        count_log_sums_[kXY] = count_log_sum(xy_counts_);
+        count_log_sums_[kYY] = count_log_sum(yy_counts_);
+        count_log_sums_[kX] = count_log_sum(x_counts_);
+        count_log_sums_[kY] = count_log_sum(y_counts_);
+        updates_since_resync_ = 0;
+    }
+
+    double entropy(Marginal marginal) const {
+        return entropy_from_count_sum(count_log_sums_[marginal], size_);
+    }
+
+    size_t window_size_;
+
+    std::vector<uint8_t> ring_;
+    size_t head_;
+    size_t size_;
+    bool has_previous_;
+    uint8_t previous_x_;
+    uint8_t previous_y_;
+
+    std::array<uint32_t, 27> joint_counts_;
+    std::array<uint32_t, 9> xy_counts_;
+    std::array<uint32_t, 9> yy_counts_;
+    std::array<uint32_t, 3> x_counts_;
+    std::array<uint32_t, 3> y_counts_;
+    std::array<double, kMarginals> count_log_sums_;
+    size_t updates_since_resync_;
+};
+
+#endif // TRANSFER_ENTROPY_CALCULATOR_HPP
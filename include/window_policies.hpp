@@ -0,0 +1,127 @@
+#ifndef WINDOW_POLICIES_HPP
+#define WINDOW_POLICIES_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+// Window-adaptation rules for SlidingEntropyCalculator. The calculator calls
+// next_window_size() every adaptation_interval actions (not per action) and
+// skips the call entirely when a policy sets kAdaptive = false.
+
+// Snapshot handed to a policy at each evaluation
+struct WindowAdaptationContext {
+    double current_entropy;
+    double previous_entropy;       // entropy at the previous evaluation
+    size_t window_fill;            // actions currently in the window
+    size_t window_size;            // current target size
+    size_t min_window;
+    size_t max_window;
+    size_t actions_since_last;     // actions added since the previous evaluation
+};
+
+// The original rule: grow by 10 when entropy moved more than 0.1 bits since
+// the last evaluation, shrink by 5 when it moved less than 0.01 bits
+struct EntropyChangeWindowPolicy {
+    static constexpr bool kAdaptive = true;
+
+    size_t next_window_size(const WindowAdaptationContext& ctx) {
+        double entropy_change = std::abs(ctx.current_entropy - ctx.previous_entropy);
+
+        if (entropy_change > 0.1 && ctx.window_fill < ctx.max_window) {
+            return std::min(ctx.window_fill + 10, ctx.max_window);
+        } else if (entropy_change < 0.01 && ctx.window_fill > ctx.min_window) {
+            return std::max(ctx.window_fill - 5, ctx.min_window);
+        }
+        return ctx.window_size;
+    }
+};
+
+// Fixed window: never evaluated, so adaptation costs nothing
+struct FixedWindowPolicy {
+    static constexpr bool kAdaptive = false;
+
+    size_t next_window_size(const WindowAdaptationContext& ctx) {
+        return ctx.window_size;
+    }
+};
+
+// Scales the window inversely with entropy volatility, measured as an EWMA of
+// |dH| between evaluations: calm streams get long, stable windows and
+// turbulent ones get short windows that track the new regime quickly.
+class VolatilityScaledWindowPolicy {
+public:
+    static constexpr bool kAdaptive = true;
+
+    explicit VolatilityScaledWindowPolicy(size_t base_window = 100,
+                                          double reference_volatility = 0.05,
+                                          double smoothing = 0.1)
+        : base_window_(base_window)
+        , reference_volatility_(reference_volatility)
+        , smoothing_(smoothing)
+        , volatility_(reference_volatility)
+    {}
+
+    size_t next_window_size(const WindowAdaptationContext& ctx) {
+        double entropy_change = std::abs(ctx.current_entropy - ctx.previous_entropy);
+        volatility_ += smoothing_ * (entropy_change - volatility_);
+
+        double scale = reference_volatility_ / std::max(volatility_, 1e-9);
+        double target = static_cast<double>(base_window_) * scale;
+        target = std::min(std::max(target, static_cast<double>(ctx.min_window)),
+                          static_cast<double>(ctx.max_window));
+        return static_cast<size_t>(target);
+    }
+
+    double get_volatility() const { return volatility_; }
+
+private:
+    size_t base_window_;
+    double reference_volatility_;
+    double smoothing_;
+    double volatility_;
+};
+
+// Sizes the window to cover a target span of time at the observed arrival
+// rate, so a window means roughly the same number of seconds at the open and
+// at midday. The rate is an EWMA of actions per second between evaluations.
+class ArrivalRateWindowPolicy {
+public:
+    static constexpr bool kAdaptive = true;
+    using Clock = std::chrono::steady_clock;
+
+    explicit ArrivalRateWindowPolicy(std::chrono::nanoseconds target_span = std::chrono::seconds(60),
+                                     double smoothing = 0.2)
+        : target_span_seconds_(std::chrono::duration<double>(target_span).count())
+        , smoothing_(smoothing)
+        , rate_per_second_(0.0)
+        , last_evaluation_(Clock::now())
+    {}
+
+    size_t next_window_size(const WindowAdaptationContext& ctx) {
+        auto now = Clock::now();
+        double elapsed = std::chrono::duration<double>(now - last_evaluation_).count();
+        last_evaluation_ = now;
+
+        if (elapsed <= 0.0) return ctx.window_size;
+
+        double rate = static_cast<double>(ctx.actions_since_last) / elapsed;
+        rate_per_second_ = rate_per_second_ > 0.0 ? rate_per_second_ + smoothing_ * (rate - rate_per_second_) : rate;
+
+        double target = rate_per_second_ * target_span_seconds_;
+        target = std::min(std::max(target, static_cast<double>(ctx.min_window)),
+                          static_cast<double>(ctx.max_window));
+        return static_cast<size_t>(target);
+    }
+
+    double get_arrival_rate() const { return rate_per_second_; }
+
+private:
+    double target_span_seconds_;
+    double smoothing_;
+    double rate_per_second_;
+    Clock::time_point last_evaluation_;
+};
+
+#endif // WINDOW_POLICIES_HPP
@@ -0,0 +1,259 @@
+#ifndef WIRE_FORMAT_HPP
+#define WIRE_FORMAT_HPP
+
+#include "market_data.hpp"
+#include "market_event.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Binary wire format for action batches and MarketEvent batches. A buffer is
+// a sequence of frames; every integer is little-endian and every frame is
+// padded to a multiple of 8 bytes, so event payloads stay 8-byte aligned when
+// the buffer is.
+//
+//   Frame header (24 bytes)
+//     0  u32  magic    'QEWF' (0x46574551)
+//     4  u8   version  kWireVersion
+//     5  u8   kind     WireFrameKind
+//     6  u16  flags    reserved, 0
+//     8  u32  symbol_id
+//    12  u32  count    actions or events in the payload
+//    16  u32  payload  payload bytes including padding (a multiple of 8)
+//    20  u32  reserved 0
+//   ACTIONS payload: count bytes, one state index (TraderAction) per byte
+//   EVENTS payload:  count x 32-byte records laid out like MarketEvent
+//
+// Readers never copy payloads: WireReader hands out a MarketDataView over the
+// action bytes or a MarketEventView over the event records, both pointing
+// into the caller's buffer. Readers accept any version up to their own and
+// skip frames of unknown kind by their payload length, so the format can grow.
+
+constexpr uint32_t kWireMagic = 0x46574551;  // "QEWF" in little-endian
+constexpr uint8_t kWireVersion = 1;
+constexpr size_t kWireHeaderSize = 24;
+constexpr size_t kWireEventSize = 32;
+
+enum class WireFrameKind : uint8_t {
+    ACTIONS = 1,
+    EVENTS = 2
+};
+
+enum class WireStatus : uint8_t {
+    OK = 0,
+    END,                  // no more frames
+    TRUNCATED,            // header or payload runs past the buffer
+    BAD_MAGIC,
+    UNSUPPORTED_VERSION,
+    INVALID_ACTION,       // action byte outside HOLD/BUY/SELL
+    BAD_LENGTH            // payload length unaligned or too short for count
+};
+
+namespace wire_detail {
+
+inline uint32_t load_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline uint64_t load_u64(const uint8_t* p) {
+    return static_cast<uint64_t>(load_u32(p)) | static_cast<uint64_t>(load_u32(p + 4)) << 32;
+}
+
+inline void store_u32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline void store_u64(uint8_t* p, uint64_t v) {
+    store_u32(p, static_cast<uint32_t>(v));
+    store_u32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+constexpr size_t padded(size_t bytes) {
+    return (bytes + 7) & ~size_t{7};
+}
+
+inline bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+} // namespace wire_detail
+
+// Non-owning view of EVENTS payload records
+class MarketEventView {
+public:
+    MarketEventView() : data_(nullptr), size_(0) {}
+    MarketEventView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Decodes one record; on little-endian hosts this is a plain 32-byte copy
+    MarketEvent event_at(size_t index) const {
+        const uint8_t* p = data_ + index * kWireEventSize;
+        MarketEvent event;
+        if (wire_detail::host_is_little_endian()) {
+            std::memcpy(&event, p, sizeof(event));
+            return event;
+        }
+        event = MarketEvent{};
+        event.timestamp_ns = wire_detail::load_u64(p);
+        event.price_ticks = static_cast<int64_t>(wire_detail::load_u64(p + 8));
+        event.size = wire_detail::load_u32(p + 16);
+        event.symbol_id = wire_detail::load_u32(p + 20);
+        event.action = static_cast<TraderAction>(p[24]);
+        event.flags = p[25];
+        return event;
+    }
+
+    TraderAction action_at(size_t index) const {
+        return static_cast<TraderAction>(data_[index * kWireEventSize + offsetof(MarketEvent, action)]);
+    }
+
+    template <typename Fn>
+    void for_each_event(Fn&& fn) const {
+        for (size_t i = 0; i < size_; ++i) fn(event_at(i));
+    }
+
+    // Reads only the action byte of each record
+    template <typename Fn>
+    void for_each_action(Fn&& fn) const {
+        for (size_t i = 0; i < size_; ++i) fn(action_at(i));
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+struct WireFrame {
+    WireFrameKind kind;
+    uint8_t version;
+    uint32_t symbol_id;
+    MarketDataView actions;   // ACTIONS frames
+    MarketEventView events;   // EVENTS frames
+};
+
+// Walks the frames of a buffer in place
+class WireReader {
+public:
+    WireReader(const void* buffer, size_t size)
+        : data_(static_cast<const uint8_t*>(buffer))
+        , size_(size)
+        , offset_(0)
+    {}
+
+    // Next known frame, END at the end of the buffer, or an error status
+    // (the reader stops at the first error)
+    WireStatus next(WireFrame& frame) {
+        for (;;) {
+            if (offset_ == size_) return WireStatus::END;
+            if (size_ - offset_ < kWireHeaderSize) return fail(WireStatus::TRUNCATED);
+
+            const uint8_t* header = data_ + offset_;
+            if (wire_detail::load_u32(header) != kWireMagic) return fail(WireStatus::BAD_MAGIC);
+            uint8_t version = header[4];
+            if (version == 0 || version > kWireVersion) return fail(WireStatus::UNSUPPORTED_VERSION);
+
+            auto kind = static_cast<WireFrameKind>(header[5]);
+            uint32_t count = wire_detail::load_u32(header + 12);
+            size_t payload = wire_detail::load_u32(header + 16);
+            if (payload % 8 != 0) return fail(WireStatus::BAD_LENGTH);
+            if (size_ - offset_ - kWireHeaderSize < payload) return fail(WireStatus::TRUNCATED);
+
+            const uint8_t* body = header + kWireHeaderSize;
+            offset_ += kWireHeaderSize + payload;
+
+            if (kind != WireFrameKind::ACTIONS && kind != WireFrameKind::EVENTS) continue;  // unknown: skip
+
+            size_t record_size = kind == WireFrameKind::EVENTS ? kWireEventSize : 1;
+            if (payload < static_cast<size_t>(count) * record_size) return fail(WireStatus::BAD_LENGTH);
+
+            frame.kind = kind;
+            frame.version = version;
+            frame.symbol_id = wire_detail::load_u32(header + 8);
+            frame.actions = MarketDataView();
+            frame.events = MarketEventView();
+
+            if (kind == WireFrameKind::ACTIONS) {
+                if (!valid_action_bytes(body, count)) return fail(WireStatus::INVALID_ACTION);
+                frame.actions = MarketDataView(body, count);
+            } else {
+                if (!valid_action_bytes(body + offsetof(MarketEvent, action), count, kWireEventSize)) {
+                    return fail(WireStatus::INVALID_ACTION);
+                }
+                frame.events = MarketEventView(body, count);
+            }
+            return WireStatus::OK;
+        }
+    }
+
+    size_t offset() const { return offset_; }
+
+private:
+    WireStatus fail(WireStatus status) {
+        offset_ = size_;
+        return status;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_;
+};
+
+namespace wire_detail {
+
+inline uint8_t* append_header(std::vector<uint8_t>& out, WireFrameKind kind, uint32_t symbol_id,
+                              uint32_t count, size_t payload) {
+    size_t start = out.size();
+    out.resize(start + kWireHeaderSize + padded(payload), 0);
+    uint8_t* header = out.data() + start;
+    store_u32(header, kWireMagic);
+    header[4] = kWireVersion;
+    header[5] = static_cast<uint8_t>(kind);
+    store_u32(header + 8, symbol_id);
+    store_u32(header + 12, count);
+    store_u32(header + 16, static_cast<uint32_t>(padded(payload)));
+    return header + kWireHeaderSize;
+}
+
+} // namespace wire_detail
+
+// Append an ACTIONS frame for data
+inline void append_wire_actions(std::vector<uint8_t>& out, uint32_t symbol_id, const MarketData& data) {
+    uint8_t* body = wire_detail::append_header(out, WireFrameKind::ACTIONS, symbol_id,
+                                               static_cast<uint32_t>(data.size()), data.size());
+    data.for_each_action([&body](TraderAction action) { *body++ = static_cast<uint8_t>(action); });
+}
+
+inline void append_wire_actions(std::vector<uint8_t>& out, uint32_t symbol_id,
+                                const TraderAction* actions, size_t count) {
+    uint8_t* body = wire_detail::append_header(out, WireFrameKind::ACTIONS, symbol_id,
+                                               static_cast<uint32_t>(count), count);
+    std::memcpy(body, actions, count);
+}
+
+// Append an EVENTS frame; symbol_id in the header is informational
+inline void append_wire_events(std::vector<uint8_t>& out, uint32_t symbol_id,
+                               const MarketEvent* events, size_t count) {
+    uint8_t* body = wire_detail::append_header(out, WireFrameKind::EVENTS, symbol_id,
+                                               static_cast<uint32_t>(count), count * kWireEventSize);
+    if (wire_detail::host_is_little_endian()) {
+        std::memcpy(body, events, count * kWireEventSize);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i, body += kWireEventSize) {
+        wire_detail::store_u64(body, events[i].timestamp_ns);
+        wire_detail::store_u64(body + 8, static_cast<uint64_t>(events[i].price_ticks));
+        wire_detail::store_u32(body + 16, events[i].size);
+        wire_detail::store_u32(body + 20, events[i].symbol_id);
+        body[24] = static_cast<uint8_t>(events[i].action);
+        body[25] = events[i].flags;
+    }
+}
+
+#endif // WIRE_FORMAT_HPP
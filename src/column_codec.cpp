@@ -0,0 +1,252 @@
+// Run-length/2-bit action codec and delta/zigzag/bit-packed integer codec
+#include "column_codec.hpp"
+#include "wire_format.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr uint8_t kLiteralTag = 0x00;
+constexpr uint8_t kRunTag = 0x40;
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+void put_literal(std::vector<uint8_t>& out, const uint8_t* actions, size_t count) {
+    if (count == 0) return;
+    out.push_back(kLiteralTag);
+    put_varint(out, count);
+
+    size_t start = out.size();
+    out.resize(start + (count + 3) / 4, 0);
+    uint8_t* packed = out.data() + start;
+    for (size_t i = 0; i < count; ++i) {
+        packed[i / 4] |= static_cast<uint8_t>((actions[i] & 3) << (2 * (i % 4)));
+    }
+}
+
+// Unpacks count 2-bit actions; false if any is 3. Each packed byte is spread
+// over four output bytes, then bit 0 and bit 1 of every field are tested with
+// a per-byte mask so no variable shift is needed.
+bool unpack_literal(const uint8_t* packed, size_t count, uint8_t* out) {
+    size_t i = 0;
+    uint8_t invalid = 0;
+
+#if defined(__SSE2__)
+    const __m128i low_bits = _mm_set1_epi32(0x40100401);
+    const __m128i high_bits = _mm_set1_epi32(static_cast<int>(0x80200802u));
+    __m128i bad = _mm_setzero_si128();
+
+    auto expand = [&](__m128i spread, uint8_t* dst) {
+        __m128i low = _mm_cmpeq_epi8(_mm_and_si128(spread, low_bits), low_bits);
+        __m128i high = _mm_cmpeq_epi8(_mm_and_si128(spread, high_bits), high_bits);
+        bad = _mm_or_si128(bad, _mm_and_si128(low, high));
+        // low and high are 0 or -1, so -(low + 2 * high) is the action
+        __m128i value = _mm_sub_epi8(_mm_setzero_si128(), _mm_add_epi8(low, _mm_add_epi8(high, high)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value);
+    };
+
+    for (; i + 64 <= count; i += 64) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + i / 4));
+        __m128i lo = _mm_unpacklo_epi8(v, v);
+        __m128i hi = _mm_unpackhi_epi8(v, v);
+        expand(_mm_unpacklo_epi16(lo, lo), out + i);
+        expand(_mm_unpackhi_epi16(lo, lo), out + i + 16);
+        expand(_mm_unpacklo_epi16(hi, hi), out + i + 32);
+        expand(_mm_unpackhi_epi16(hi, hi), out + i + 48);
+    }
+    // Short literals between runs: 16 actions from 4 packed bytes
+    for (; i + 16 <= count; i += 16) {
+        uint32_t word;
+        std::memcpy(&word, packed + i / 4, sizeof(word));
+        __m128i v = _mm_cvtsi32_si128(static_cast<int>(word));
+        v = _mm_unpacklo_epi8(v, v);
+        expand(_mm_unpacklo_epi16(v, v), out + i);
+    }
+    invalid = static_cast<uint8_t>(_mm_movemask_epi8(bad) != 0);
+#endif
+
+    for (; i < count; ++i) {
+        uint8_t action = static_cast<uint8_t>((packed[i / 4] >> (2 * (i % 4))) & 3);
+        invalid |= static_cast<uint8_t>(action == 3);
+        out[i] = action;
+    }
+    return invalid == 0;
+}
+
+uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+unsigned bit_width(uint64_t value) {
+    return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+// In-place inclusive prefix sum with wrapping u64 adds. The SSE2 path scans
+// two values per step: the lane pair [a, b] becomes [a, a + b] with one
+// 8-byte shift, then the running total, kept broadcast in both lanes, is added.
+void prefix_sum(uint64_t* values, size_t count) {
+    size_t i = 0;
+    uint64_t total = 0;
+
+#if defined(__SSE2__)
+    __m128i carry = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        v = _mm_add_epi64(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi64(v, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), v);
+        carry = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    if (i > 0) total = values[i - 1];
+#endif
+
+    for (; i < count; ++i) {
+        total += values[i];
+        values[i] = total;
+    }
+}
+
+} // namespace
+
+void encode_actions(const uint8_t* actions, size_t count, std::vector<uint8_t>& out) {
+    size_t literal_start = 0;
+    size_t i = 0;
+    while (i < count) {
+        size_t run = 1;
+        while (i + run < count && actions[i + run] == actions[i]) ++run;
+
+        if (run >= kActionMinRun) {
+            put_literal(out, actions + literal_start, i - literal_start);
+            out.push_back(static_cast<uint8_t>(kRunTag | (actions[i] & 3)));
+            put_varint(out, run);
+            literal_start = i + run;
+        }
+        i += run;
+    }
+    put_literal(out, actions + literal_start, count - literal_start);
+}
+
+bool decode_actions(const uint8_t* in, size_t size, size_t count, uint8_t* out) {
+    const uint8_t* p = in;
+    const uint8_t* end = in + size;
+    size_t decoded = 0;
+
+    while (decoded < count) {
+        if (p == end) return false;
+        uint8_t tag = *p++;
+        uint64_t n;
+        if (!get_varint(p, end, n) || n == 0 || n > count - decoded) return false;
+
+        if (tag == kLiteralTag) {
+            size_t packed = static_cast<size_t>((n + 3) / 4);
+            if (static_cast<size_t>(end - p) < packed) return false;
+            if (!unpack_literal(p, static_cast<size_t>(n), out + decoded)) return false;
+            p += packed;
+        } else if ((tag & ~uint8_t{3}) == kRunTag && (tag & 3) != 3) {
+            std::memset(out + decoded, tag & 3, static_cast<size_t>(n));
+        } else {
+            return false;
+        }
+        decoded += static_cast<size_t>(n);
+    }
+    return p == end;
+}
+
+void encode_deltas(const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+    for (size_t block = 0; block < count; block += kDeltaBlockSize) {
+        size_t n = std::min(kDeltaBlockSize, count - block);
+        const int64_t* v = values + block;
+
+        // Differences in unsigned arithmetic wrap instead of overflowing
+        uint64_t deltas[kDeltaBlockSize];
+        uint64_t all_bits = 0;
+        for (size_t j = 1; j < n; ++j) {
+            deltas[j] = zigzag(static_cast<uint64_t>(v[j]) - static_cast<uint64_t>(v[j - 1]));
+            all_bits |= deltas[j];
+        }
+        unsigned width = bit_width(all_bits);
+
+        size_t start = out.size();
+        size_t packed_bytes = ((n - 1) * width + 7) / 8;
+        out.resize(start + 9 + packed_bytes, 0);
+        uint8_t* header = out.data() + start;
+        wire_detail::store_u64(header, static_cast<uint64_t>(v[0]));
+        header[8] = static_cast<uint8_t>(width);
+
+        uint8_t* packed = header + 9;
+        size_t bit = 0;
+        for (size_t j = 1; j < n; ++j, bit += width) {
+            for (unsigned b = 0; b < width; b += 8) {
+                // Up to 8 bits of this delta into at most two bytes
+                uint64_t chunk = (deltas[j] >> b) & 0xFF;
+                unsigned bits = std::min(8u, width - b);
+                size_t at = bit + b;
+                uint16_t shifted = static_cast<uint16_t>((chunk & ((1u << bits) - 1)) << (at % 8));
+                packed[at / 8] |= static_cast<uint8_t>(shifted);
+                if ((at % 8) + bits > 8) packed[at / 8 + 1] |= static_cast<uint8_t>(shifted >> 8);
+            }
+        }
+    }
+    out.insert(out.end(), 8, 0);
+}
+
+bool decode_deltas(const uint8_t* in, size_t size, size_t count, int64_t* out) {
+    const uint8_t* p = in;
+    const uint8_t* end = in + size;
+
+    for (size_t block = 0; block < count; block += kDeltaBlockSize) {
+        size_t n = std::min(kDeltaBlockSize, count - block);
+        if (static_cast<size_t>(end - p) < 9) return false;
+
+        uint64_t value = wire_detail::load_u64(p);
+        unsigned width = p[8];
+        p += 9;
+
+        size_t packed_bytes = ((n - 1) * width + 7) / 8;
+        // The 8 trailing bytes (next block or stream padding) cover the
+        // whole-word loads below
+        if (width > 64 || static_cast<size_t>(end - p) < packed_bytes + 8) return false;
+
+        // Unpack the first value and the deltas, then integrate the block
+        uint64_t* dst = reinterpret_cast<uint64_t*>(out + block);
+        dst[0] = value;
+        uint64_t mask = width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+
+        size_t bit = 0;
+        for (size_t j = 1; j < n; ++j, bit += width) {
+            const uint8_t* word = p + bit / 8;
+            unsigned shift = static_cast<unsigned>(bit % 8);
+            uint64_t packed = wire_detail::load_u64(word) >> shift;
+            if (shift + width > 64) packed |= static_cast<uint64_t>(word[8]) << (64 - shift);
+            dst[j] = unzigzag(packed & mask);
+        }
+        prefix_sum(dst, n);
+        p += packed_bytes;
+    }
+
+    return static_cast<size_t>(end - p) == 8;
+}
@@ -0,0 +1,299 @@
+// Memory-mapped, SIMD-delimited CSV tick ingestion
+#include "csv_tick_source.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr int kMaxFields = 32;
+
+struct LineFields {
+    const char* begin[kMaxFields];
+    const char* end[kMaxFields];
+    int count;  // fields on the line, including any beyond kMaxFields
+};
+
+// Splits the line starting at p into fields and returns the start of the next
+// line. The SSE2 path compares 16 bytes at once against the delimiter and
+// '\n' and walks only the set bits of the match mask, so bytes inside a field
+// are never looked at one by one. A trailing '\r' is dropped.
+const char* split_line(const char* p, const char* end, char delimiter, LineFields& fields) {
+    const char* field_start = p;
+    int n = 0;
+    auto close_field = [&](const char* at) {
+        if (n < kMaxFields) {
+            fields.begin[n] = field_start;
+            fields.end[n] = at;
+        }
+        ++n;
+        field_start = at + 1;
+    };
+    auto close_line = [&](const char* at) {
+        close_field(at > field_start && at[-1] == '\r' ? at - 1 : at);
+        fields.count = n;
+    };
+
+    const char* q = p;
+#if defined(__SSE2__)
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    for (; q + 16 <= end; q += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, delimiters), _mm_cmpeq_epi8(v, newlines))));
+        while (mask != 0) {
+            const char* at = q + __builtin_ctz(mask);
+            if (*at == '\n') {
+                close_line(at);
+                return at + 1;
+            }
+            close_field(at);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; q < end; ++q) {
+        if (*q == '\n') {
+            close_line(q);
+            return q + 1;
+        }
+        if (*q == delimiter) close_field(q);
+    }
+    close_line(end);
+    return end;
+}
+
+// First line start at or after pos
+const char* line_start_at(const char* pos, const char* begin, const char* end) {
+    if (pos <= begin) return begin;
+    if (pos >= end) return end;
+    if (pos[-1] == '\n') return pos;
+    const void* newline = std::memchr(pos, '\n', static_cast<size_t>(end - pos));
+    return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+template <typename T>
+bool parse_number(const char* begin, const char* end, T& value) {
+    auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+TraderAction parse_side(const char* begin, const char* end) {
+    if (begin == end) return TraderAction::HOLD;
+    switch (*begin) {
+        case 'B': case 'b': case '1': return TraderAction::BUY;
+        case 'S': case 's': case '2': return TraderAction::SELL;
+        default: return TraderAction::HOLD;
+    }
+}
+
+enum class RowStatus { BLANK, MALFORMED, OK };
+
+// Parses every field of a split line except the symbol id
+RowStatus parse_row(const LineFields& fields, const CsvTickFormat& format, int field_count, MarketEvent& event) {
+    if (fields.count == 1 && fields.begin[0] == fields.end[0]) return RowStatus::BLANK;
+    if (fields.count < field_count) return RowStatus::MALFORMED;
+
+    double price;
+    bool ok = parse_number(fields.begin[format.timestamp_column], fields.end[format.timestamp_column],
+                           event.timestamp_ns) &&
+              parse_number(fields.begin[format.price_column], fields.end[format.price_column], price);
+    if (ok && format.size_column >= 0 &&
+        fields.begin[format.size_column] != fields.end[format.size_column]) {
+        ok = parse_number(fields.begin[format.size_column], fields.end[format.size_column], event.size);
+    }
+    if (!ok) return RowStatus::MALFORMED;
+
+    event.price_ticks = price_to_ticks(price);
+    if (format.side_column >= 0) {
+        event.action = parse_side(fields.begin[format.side_column], fields.end[format.side_column]);
+    }
+    event.flags = kEventTrade | kEventReplay;
+    return RowStatus::OK;
+}
+
+std::string_view field_view(const LineFields& fields, int column) {
+    return std::string_view(fields.begin[column], static_cast<size_t>(fields.end[column] - fields.begin[column]));
+}
+
+} // namespace
+
+CsvTickSource::CsvTickSource(SymbolTable& symbols, CsvTickFormat format, size_t batch_size)
+    : symbols_(symbols)
+    , format_(format)
+    , batch_size_(std::max<size_t>(batch_size, 1))
+    , field_count_(1 + std::max({format.timestamp_column, format.symbol_column, format.price_column,
+                                 format.size_column, format.side_column}))
+{}
+
+bool CsvTickSource::open(const std::string& path) {
+    if (format_.timestamp_column < 0 || format_.price_column < 0 || field_count_ > kMaxFields) {
+        return false;
+    }
+    return file_.open(path, MappedFile::AccessPattern::SEQUENTIAL);
+}
+
+void CsvTickSource::close() {
+    file_.close();
+}
+
+// Symbols of the slice's valid rows in order of first appearance. Rows whose
+// symbol was already seen are only split, not parsed.
+void CsvTickSource::collect_symbols(const char* begin, const char* end,
+                                    std::vector<std::string_view>& first_seen) const {
+    std::unordered_set<std::string_view> seen;
+    LineFields fields;
+    const char* p = begin;
+    while (p < end) {
+        p = split_line(p, end, format_.delimiter, fields);
+        if (fields.count < field_count_) continue;
+
+        std::string_view symbol = field_view(fields, format_.symbol_column);
+        if (seen.count(symbol) != 0) continue;
+
+        MarketEvent event{};
+        if (parse_row(fields, format_, field_count_, event) == RowStatus::OK) {
+            seen.insert(symbol);
+            first_seen.push_back(symbol);
+        }
+    }
+}
+
+// Interns each slice's first-seen symbols in slice order, so ids follow first
+// appearance in the file whatever order the slices were scanned in
+CsvTickSource::SymbolIds CsvTickSource::intern_symbols(
+    const std::vector<std::vector<std::string_view>>& slice_symbols) const {
+    SymbolIds ids;
+    for (const auto& symbols : slice_symbols) {
+        for (std::string_view symbol : symbols) {
+            if (ids.count(symbol) == 0) ids.emplace(symbol, symbols_.intern(std::string(symbol)));
+        }
+    }
+    return ids;
+}
+
+CsvParseStats CsvTickSource::parse_slice(const char* begin, const char* end, const SymbolIds& symbol_ids,
+                                         const BatchSink& sink) const {
+    CsvParseStats stats;
+    stats.bytes = static_cast<uint64_t>(end - begin);
+
+    std::vector<MarketEvent> batch;
+    batch.reserve(batch_size_);
+
+    LineFields fields;
+    const char* p = begin;
+    while (p < end) {
+        p = split_line(p, end, format_.delimiter, fields);
+
+        MarketEvent event{};
+        RowStatus status = parse_row(fields, format_, field_count_, event);
+        if (status == RowStatus::BLANK) continue;
+        if (status == RowStatus::MALFORMED) {
+            stats.malformed++;
+            continue;
+        }
+        if (format_.symbol_column >= 0) {
+            event.symbol_id = symbol_ids.find(field_view(fields, format_.symbol_column))->second;
+        }
+
+        batch.push_back(event);
+        stats.rows++;
+        if (batch.size() == batch_size_) {
+            sink(batch.data(), batch.size());
+            batch.clear();
+        }
+    }
+
+    if (!batch.empty()) sink(batch.data(), batch.size());
+    return stats;
+}
+
+// Rows after the header, or an empty range for an empty file, whose mapping is null
+bool CsvTickSource::body(const char*& begin, const char*& end) const {
+    if (file_.size() == 0) return false;
+    begin = reinterpret_cast<const char*>(file_.data());
+    end = begin + file_.size();
+    if (format_.has_header) begin = line_start_at(begin + 1, begin, end);
+    return begin < end;
+}
+
+CsvParseStats CsvTickSource::parse(const BatchSink& sink) const {
+    const char* begin;
+    const char* end;
+    if (!body(begin, end)) return CsvParseStats();
+
+    std::vector<std::vector<std::string_view>> slice_symbols(1);
+    if (format_.symbol_column >= 0) collect_symbols(begin, end, slice_symbols[0]);
+    return parse_slice(begin, end, intern_symbols(slice_symbols), sink);
+}
+
+CsvParseStats CsvTickSource::parse(ThreadPool& pool, const BatchSink& sink, size_t slice_bytes) const {
+    const char* begin;
+    const char* end;
+    if (!body(begin, end)) return CsvParseStats();
+
+    // Slice i covers the lines that start in [begin + i * slice_bytes, begin + (i + 1) * slice_bytes)
+    slice_bytes = std::max<size_t>(slice_bytes, 1);
+    size_t body_bytes = static_cast<size_t>(end - begin);
+    size_t slices = (body_bytes + slice_bytes - 1) / slice_bytes;
+    std::vector<const char*> bounds(slices + 1);
+    for (size_t i = 0; i < slices; ++i) bounds[i] = line_start_at(begin + i * slice_bytes, begin, end);
+    bounds[slices] = end;
+
+    // Pass 1 finds each slice's new symbols in parallel; interning them in
+    // slice order gives the serial parse's ids. Pass 2 then reads the ids
+    // without touching the table's lock.
+    std::vector<std::vector<std::string_view>> slice_symbols(slices);
+    if (format_.symbol_column >= 0) {
+        pool.parallel_for(slices, 1, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) collect_symbols(bounds[i], bounds[i + 1], slice_symbols[i]);
+        });
+    }
+    const SymbolIds symbol_ids = intern_symbols(slice_symbols);
+
+    std::vector<CsvParseStats> slice_stats(slices);
+    pool.parallel_for(slices, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            slice_stats[i] = parse_slice(bounds[i], bounds[i + 1], symbol_ids, sink);
+        }
+    });
+
+    CsvParseStats stats;
+    for (const auto& slice : slice_stats) {
+        stats.rows += slice.rows;
+        stats.malformed += slice.malformed;
+        stats.bytes += slice.bytes;
+    }
+    return stats;
+}
+
+CsvParseStats CsvTickSource::feed(MarketPipeline& pipeline, ThreadPool& pool) const {
+    std::atomic<uint64_t> fed{0};
+
+    CsvParseStats stats = parse(pool, [&pipeline, &fed](const MarketEvent* events, size_t count) {
+        size_t sent = 0;
+        while (sent < count) {
+            size_t accepted = pipeline.feed_market_events(events + sent, count - sent);
+            sent += accepted;
+            if (accepted == 0) {
+                if (!pipeline.is_running()) break;
+                std::this_thread::yield();
+            }
+        }
+        fed.fetch_add(sent);
+    });
+
+    // Rows dropped because the pipeline stopped are not reported as emitted
+    stats.rows = fed.load();
+    return stats;
+}
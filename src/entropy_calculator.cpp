@@ -1,26 +1,55 @@
 // Core algorithm to compute Shannon entropy for TraderAction sequences
 #include "entropy_calculator.hpp"
-#include <cmath>
-#include <map>
 
-// Calculate Shannon entropy of actions; returns 0 if empty
-double EntropyCalculator::calculate_entropy(const std::vector<TraderAction>& actions) {
-    if (actions.empty()) return 0.0;
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-    std::map<TraderAction, int> counts;
-    for (const auto& action : actions) {
-        counts[action]++;
+// Count each action into a fixed three-bin histogram. Actions are bytes 0..2,
+// so per byte the value is BUY + 2 * SELL and bit 1 alone is SELL: summing the
+// raw bytes and the bit-1 bytes gives both counts, and HOLD is the rest. The
+// SSE2 path does those sums 16 bytes at a time with PSADBW into 64-bit lanes,
+// so there is no per-element branch or table lookup and no counter overflow.
+std::array<uint32_t, 3> count_trader_actions(const TraderAction* actions, size_t count) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(actions);
+    uint64_t value_sum = 0;
+    uint64_t sell_count = 0;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low_bit = _mm_set1_epi8(1);
+    __m128i value_acc = zero;
+    __m128i sell_acc = zero;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        __m128i sells = _mm_and_si128(_mm_srli_epi16(v, 1), low_bit);
+        value_acc = _mm_add_epi64(value_acc, _mm_sad_epu8(v, zero));
+        sell_acc = _mm_add_epi64(sell_acc, _mm_sad_epu8(sells, zero));
     }
 
-    double entropy = 0.0;
-    int total = static_cast<int>(actions.size());
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), value_acc);
+    value_sum = lanes[0] + lanes[1];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sell_acc);
+    sell_count = lanes[0] + lanes[1];
+#endif
 
-    for (const auto& [action, count] : counts) {
-        double p = static_cast<double>(count) / total;
-        if (p > 0) {
-            entropy -= p * std::log2(p);  // Entropy contribution
-        }
+    for (; i < count; ++i) {
+        value_sum += bytes[i];
+        sell_count += bytes[i] >> 1;
     }
 
-    return entropy;
+    uint64_t buy_count = value_sum - 2 * sell_count;
+    return {static_cast<uint32_t>(count - buy_count - sell_count),
+            static_cast<uint32_t>(buy_count),
+            static_cast<uint32_t>(sell_count)};
 }
+
+std::array<uint32_t, 3> count_trader_actions(const std::vector<TraderAction>& actions) {
+    return count_trader_actions(actions.data(), actions.size());
+}
+
+// Explicit instantiation of the default (Shannon) calculator
+template class BasicEntropyCalculator<ShannonEntropy, kTraderActionCount>;
@@ -2,21 +2,16 @@
 #include "market_data.hpp"
 #include <cstdlib>
 #include <ctime>
+#include <type_traits>
 
-// Add a trader action to the stored sequence
-void MarketData::add_action(TraderAction action) {
-    actions_.push_back(action);
-}
-
-// Retrieve all recorded trader actions
-const std::vector<TraderAction>& MarketData::get_actions() const {
-    return actions_;
-}
+// The three-state container is compiled once here
+template class BasicMarketData<kTraderActionCount>;
 
-// Clear all stored trader actions
-void MarketData::clear() {
-    actions_.clear();
-}
+// Count, 4 bytes of packed actions and the pmr spill vector; nothing else
+static_assert(sizeof(MarketData) == sizeof(std::pmr::vector<TraderAction>) + 8,
+              "MarketData grew beyond its inline storage and spill vector");
+static_assert(std::is_nothrow_move_constructible<MarketData>::value,
+              "MarketData moves must not throw");
 
 double get_spy_price() {
     static double price = 695.42;
@@ -0,0 +1,100 @@
+// Throughput benchmark for the action histogram, one-shot entropy and the
+// archive column codecs
+#include "entropy_calculator.hpp"
+#include "column_codec.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Reference implementation the SIMD path replaced
+std::array<uint32_t, 3> count_scalar(const std::vector<TraderAction>& actions) {
+    std::array<uint32_t, 3> counts{0, 0, 0};
+    for (const auto& action : actions) {
+        counts[static_cast<size_t>(action)]++;
+    }
+    return counts;
+}
+
+template <typename Fn>
+double measure_gb_per_second(size_t bytes, size_t iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(bytes) * static_cast<double>(iterations) / seconds / 1e9;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t{1} << 26);
+    size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    std::mt19937 rng(42);
+    std::vector<TraderAction> actions(size);
+    for (auto& action : actions) {
+        action = static_cast<TraderAction>(rng() % 3);
+    }
+
+    if (count_scalar(actions) != count_trader_actions(actions)) {
+        std::cerr << "Histogram mismatch between scalar and SIMD paths" << std::endl;
+        return 1;
+    }
+
+    volatile uint32_t sink = 0;
+    double scalar = measure_gb_per_second(size, iterations, [&] { sink = sink + count_scalar(actions)[1]; });
+    double simd = measure_gb_per_second(size, iterations, [&] { sink = sink + count_trader_actions(actions)[1]; });
+
+    EntropyCalculator calculator;
+    volatile double entropy_sink = 0.0;
+    double entropy = measure_gb_per_second(size, iterations, [&] {
+        entropy_sink = entropy_sink + calculator.calculate_entropy(actions.data(), actions.size());
+    });
+
+    std::cout << "Actions: " << size << " x " << iterations << " iterations\n"
+              << "Scalar histogram:  " << scalar << " GB/s\n"
+              << "SIMD histogram:    " << simd << " GB/s\n"
+              << "calculate_entropy: " << entropy << " GB/s" << std::endl;
+
+    // Codec decode speed is reported against the decoded (uncompressed) size,
+    // i.e. the disk bandwidth it would take to read the raw column instead
+    const auto* action_bytes = reinterpret_cast<const uint8_t*>(actions.data());
+    std::vector<uint8_t> encoded_actions;
+    encode_actions(action_bytes, size, encoded_actions);
+    std::vector<uint8_t> decoded_actions(size);
+
+    // Random-walk prices in ticks, the shape of a real price column
+    std::vector<int64_t> prices(size / 8);
+    int64_t price = 6954200;
+    for (auto& tick : prices) {
+        price += static_cast<int64_t>(rng() % 41) - 20;
+        tick = price;
+    }
+    std::vector<uint8_t> encoded_prices;
+    encode_deltas(prices.data(), prices.size(), encoded_prices);
+    std::vector<int64_t> decoded_prices(prices.size());
+
+    if (!decode_actions(encoded_actions.data(), encoded_actions.size(), size, decoded_actions.data()) ||
+        decoded_actions != std::vector<uint8_t>(action_bytes, action_bytes + size) ||
+        !decode_deltas(encoded_prices.data(), encoded_prices.size(), prices.size(), decoded_prices.data()) ||
+        decoded_prices != prices) {
+        std::cerr << "Codec round trip mismatch" << std::endl;
+        return 1;
+    }
+
+    double action_decode = measure_gb_per_second(size, iterations, [&] {
+        decode_actions(encoded_actions.data(), encoded_actions.size(), size, decoded_actions.data());
+    });
+    double price_decode = measure_gb_per_second(prices.size() * sizeof(int64_t), iterations, [&] {
+        decode_deltas(encoded_prices.data(), encoded_prices.size(), prices.size(), decoded_prices.data());
+    });
+
+    std::cout << "Action decode:     " << action_decode << " GB/s (ratio "
+              << static_cast<double>(size) / encoded_actions.size() << ")\n"
+              << "Price decode:      " << price_decode << " GB/s (ratio "
+              << static_cast<double>(prices.size() * sizeof(int64_t)) / encoded_prices.size() << ")" << std::endl;
+    return 0;
+}
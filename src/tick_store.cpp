@@ -0,0 +1,335 @@
+// Columnar tick store writer and memory-mapped reader
+#include "tick_store.hpp"
+#include "column_codec.hpp"
+#include "wire_format.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+const char* const kColumnFiles[] = {"timestamp.col", "symbol.col", "price.col", "size.col", "action.col", "time.idx"};
+const size_t kColumnWidths[] = {sizeof(uint64_t), sizeof(uint32_t), sizeof(int64_t), sizeof(uint32_t), sizeof(uint8_t)};
+const char* const kCompressedFiles[] = {"timestamp.cz", nullptr, "price.cz", nullptr, "action.cz", nullptr};
+const char* const kMetaFile = "meta.bin";
+
+// meta.bin layout
+struct TickStoreMeta {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t rows;
+    uint32_t index_stride;
+    uint32_t column_count;
+    uint32_t flags;  // TickStoreCompression, version 2 on
+    uint32_t reserved;
+};
+
+static_assert(sizeof(TickStoreMeta) == 32, "meta.bin is 32 bytes");
+
+std::string join_path(const std::string& directory, const char* file) {
+    return directory + "/" + file;
+}
+
+const char* file_name(size_t column, TickStoreCompression compression) {
+    bool compressed = compression == TickStoreCompression::COLUMN_CODEC && kCompressedFiles[column] != nullptr;
+    return compressed ? kCompressedFiles[column] : kColumnFiles[column];
+}
+
+template <typename T>
+bool write_all(std::FILE* file, const std::vector<T>& values) {
+    return values.empty() || std::fwrite(values.data(), sizeof(T), values.size(), file) == values.size();
+}
+
+bool write_chunk(std::FILE* file, size_t rows, const std::vector<uint8_t>& encoded) {
+    if (rows == 0) return true;
+    uint8_t header[8];
+    wire_detail::store_u32(header, static_cast<uint32_t>(rows));
+    wire_detail::store_u32(header + 4, static_cast<uint32_t>(encoded.size()));
+    return std::fwrite(header, sizeof(header), 1, file) == 1 &&
+           std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+}
+
+// Decodes every chunk of a compressed column file into out
+template <typename T>
+bool decode_chunks(const std::string& path, uint64_t rows, std::vector<T>& out,
+                   bool (*decode)(const uint8_t*, size_t, size_t, T*)) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+
+    out.resize(static_cast<size_t>(rows));
+    const uint8_t* p = file.data();
+    const uint8_t* end = p + file.size();
+    uint64_t row = 0;
+    while (p != end) {
+        if (end - p < 8) return false;
+        uint32_t chunk_rows = wire_detail::load_u32(p);
+        uint32_t bytes = wire_detail::load_u32(p + 4);
+        p += 8;
+        if (static_cast<size_t>(end - p) < bytes || chunk_rows > rows - row ||
+            !decode(p, bytes, chunk_rows, out.data() + row)) {
+            return false;
+        }
+        p += bytes;
+        row += chunk_rows;
+    }
+    return row == rows;
+}
+
+} // namespace
+
+TickStoreWriter::TickStoreWriter(size_t index_stride, size_t buffer_rows, TickStoreCompression compression)
+    : index_stride_(std::max<size_t>(index_stride, 1))
+    , buffer_rows_(std::max<size_t>(buffer_rows, 1))
+    , compression_(compression)
+    , files_{}
+    , rows_(0)
+    , last_timestamp_(0)
+    , open_(false)
+    , failed_(false)
+{}
+
+TickStoreWriter::~TickStoreWriter() {
+    close();
+}
+
+bool TickStoreWriter::open(const std::string& directory) {
+    close();
+    if (!wire_detail::host_is_little_endian()) return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return false;
+
+    directory_ = directory;
+    for (size_t i = 0; i < kFileCount; ++i) {
+        files_[i] = std::fopen(join_path(directory, file_name(i, compression_)).c_str(), "wb");
+        if (files_[i] == nullptr) {
+            for (auto& file : files_) {
+                if (file != nullptr) std::fclose(file);
+                file = nullptr;
+            }
+            return false;
+        }
+    }
+    // Stale metadata would make a half-written store look complete
+    std::remove(join_path(directory, kMetaFile).c_str());
+
+    timestamps_.reserve(buffer_rows_);
+    symbols_.reserve(buffer_rows_);
+    prices_.reserve(buffer_rows_);
+    sizes_.reserve(buffer_rows_);
+    actions_.reserve(buffer_rows_);
+
+    rows_ = 0;
+    last_timestamp_ = 0;
+    open_ = true;
+    failed_ = false;
+    return true;
+}
+
+bool TickStoreWriter::append(const MarketEvent& event) {
+    if (!open_ || failed_ || event.timestamp_ns < last_timestamp_) return false;
+
+    if (rows_ % index_stride_ == 0) {
+        index_.push_back(TickIndexEntry{event.timestamp_ns, rows_});
+    }
+
+    timestamps_.push_back(event.timestamp_ns);
+    symbols_.push_back(event.symbol_id);
+    prices_.push_back(event.price_ticks);
+    sizes_.push_back(event.size);
+    actions_.push_back(static_cast<uint8_t>(event.action));
+    last_timestamp_ = event.timestamp_ns;
+    rows_++;
+
+    if (timestamps_.size() >= buffer_rows_) return flush();
+    return true;
+}
+
+bool TickStoreWriter::append(const MarketEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!append(events[i])) return false;
+    }
+    return true;
+}
+
+bool TickStoreWriter::flush() {
+    bool ok;
+    if (compression_ == TickStoreCompression::COLUMN_CODEC) {
+        size_t rows = timestamps_.size();
+        encoded_.clear();
+        encode_deltas(reinterpret_cast<const int64_t*>(timestamps_.data()), rows, encoded_);
+        ok = write_chunk(files_[TIMESTAMP], rows, encoded_);
+        encoded_.clear();
+        encode_deltas(prices_.data(), rows, encoded_);
+        ok = ok && write_chunk(files_[PRICE], rows, encoded_);
+        encoded_.clear();
+        encode_actions(actions_.data(), rows, encoded_);
+        ok = ok && write_chunk(files_[ACTION], rows, encoded_);
+    } else {
+        ok = write_all(files_[TIMESTAMP], timestamps_) && write_all(files_[PRICE], prices_) &&
+             write_all(files_[ACTION], actions_);
+    }
+    ok = ok && write_all(files_[SYMBOL], symbols_) && write_all(files_[SIZE], sizes_) &&
+         write_all(files_[INDEX], index_);
+
+    timestamps_.clear();
+    symbols_.clear();
+    prices_.clear();
+    sizes_.clear();
+    actions_.clear();
+    index_.clear();
+
+    if (!ok) failed_ = true;
+    return ok;
+}
+
+bool TickStoreWriter::write_meta() {
+    // Uncompressed stores stay version 1 so older readers still open them
+    bool compressed = compression_ != TickStoreCompression::NONE;
+    TickStoreMeta meta{kTickStoreMagic, compressed ? kTickStoreVersion : 1, rows_,
+                       static_cast<uint32_t>(index_stride_), 5, static_cast<uint32_t>(compression_), 0};
+    std::FILE* file = std::fopen(join_path(directory_, kMetaFile).c_str(), "wb");
+    if (file == nullptr) return false;
+    bool ok = std::fwrite(&meta, sizeof(meta), 1, file) == 1;
+    return std::fclose(file) == 0 && ok;
+}
+
+bool TickStoreWriter::close() {
+    if (!open_) return false;
+
+    bool ok = flush();
+    for (auto& file : files_) {
+        ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+    }
+    ok = ok && !failed_ && write_meta();
+
+    open_ = false;
+    return ok;
+}
+
+TickStoreReader::TickStoreReader()
+    : column_data_{}
+    , rows_(0)
+    , index_stride_(1)
+    , compression_(TickStoreCompression::NONE)
+    , open_(false)
+{}
+
+bool TickStoreReader::open(const std::string& directory) {
+    close();
+    if (!wire_detail::host_is_little_endian()) return false;
+
+    MappedFile meta_file;
+    if (!meta_file.open(join_path(directory, kMetaFile), MappedFile::AccessPattern::NORMAL) ||
+        meta_file.size() != sizeof(TickStoreMeta)) {
+        return false;
+    }
+
+    TickStoreMeta meta;
+    std::memcpy(&meta, meta_file.data(), sizeof(meta));
+    if (meta.magic != kTickStoreMagic || meta.version == 0 || meta.version > kTickStoreVersion ||
+        meta.index_stride == 0 || meta.flags > static_cast<uint32_t>(TickStoreCompression::COLUMN_CODEC)) {
+        return false;
+    }
+    compression_ = static_cast<TickStoreCompression>(meta.flags);
+
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (compression_ == TickStoreCompression::COLUMN_CODEC && kCompressedFiles[i] != nullptr) continue;
+        if (!columns_[i].open(join_path(directory, kColumnFiles[i])) ||
+            columns_[i].size() != meta.rows * kColumnWidths[i]) {
+            close();
+            return false;
+        }
+        column_data_[i] = columns_[i].data();
+    }
+    if (compression_ == TickStoreCompression::COLUMN_CODEC && !decode_columns(directory, meta.rows)) {
+        close();
+        return false;
+    }
+    // action_view() hands these bytes to calculators that index by them;
+    // decode_actions has already checked the compressed form
+    if (compression_ == TickStoreCompression::NONE && !valid_action_bytes(column_data_[4], meta.rows)) {
+        close();
+        return false;
+    }
+
+    uint64_t index_entries = (meta.rows + meta.index_stride - 1) / meta.index_stride;
+    if (!index_.open(join_path(directory, kColumnFiles[5]), MappedFile::AccessPattern::RANDOM) ||
+        index_.size() != index_entries * sizeof(TickIndexEntry)) {
+        close();
+        return false;
+    }
+
+    rows_ = meta.rows;
+    index_stride_ = meta.index_stride;
+    open_ = true;
+    return true;
+}
+
+bool TickStoreReader::decode_columns(const std::string& directory, uint64_t rows) {
+    if (!decode_chunks(join_path(directory, kCompressedFiles[0]), rows, decoded_timestamps_, decode_deltas) ||
+        !decode_chunks(join_path(directory, kCompressedFiles[2]), rows, decoded_prices_, decode_deltas) ||
+        !decode_chunks(join_path(directory, kCompressedFiles[4]), rows, decoded_actions_, decode_actions)) {
+        return false;
+    }
+    column_data_[0] = reinterpret_cast<const uint8_t*>(decoded_timestamps_.data());
+    column_data_[2] = reinterpret_cast<const uint8_t*>(decoded_prices_.data());
+    column_data_[4] = decoded_actions_.data();
+    return true;
+}
+
+void TickStoreReader::close() {
+    for (auto& column : columns_) column.close();
+    index_.close();
+    column_data_.fill(nullptr);
+    decoded_timestamps_ = std::vector<int64_t>();
+    decoded_prices_ = std::vector<int64_t>();
+    decoded_actions_ = std::vector<uint8_t>();
+    rows_ = 0;
+    compression_ = TickStoreCompression::NONE;
+    open_ = false;
+}
+
+MarketDataView TickStoreReader::action_view(uint64_t begin, uint64_t end) const {
+    end = std::min(end, rows_);
+    begin = std::min(begin, end);
+    return MarketDataView(actions() + begin, static_cast<size_t>(end - begin));
+}
+
+MarketEvent TickStoreReader::event_at(uint64_t row) const {
+    MarketEvent event{};
+    event.timestamp_ns = timestamps()[row];
+    event.price_ticks = price_ticks()[row];
+    event.size = sizes()[row];
+    event.symbol_id = symbol_ids()[row];
+    event.action = static_cast<TraderAction>(actions()[row]);
+    event.flags = kEventReplay;
+    return event;
+}
+
+size_t TickStoreReader::read_events(uint64_t row, size_t count, MarketEvent* out) const {
+    if (row >= rows_) return 0;
+    size_t n = static_cast<size_t>(std::min<uint64_t>(count, rows_ - row));
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = event_at(row + i);
+    }
+    return n;
+}
+
+uint64_t TickStoreReader::lower_bound(uint64_t timestamp_ns) const {
+    if (rows_ == 0) return 0;
+
+    // Last index entry strictly before the target bounds the search from below
+    const auto* entries = reinterpret_cast<const TickIndexEntry*>(index_.data());
+    size_t entry_count = index_.size() / sizeof(TickIndexEntry);
+    const TickIndexEntry* after = std::lower_bound(entries, entries + entry_count, timestamp_ns,
+        [](const TickIndexEntry& entry, uint64_t ts) { return entry.timestamp_ns < ts; });
+
+    uint64_t first = after == entries ? 0 : (after - 1)->row;
+    uint64_t last = after == entries + entry_count ? rows_ : after->row;
+
+    const uint64_t* ts = timestamps();
+    return static_cast<uint64_t>(std::lower_bound(ts + first, ts + last, timestamp_ns) - ts);
+}
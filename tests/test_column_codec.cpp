@@ -0,0 +1,141 @@
+// Column codecs: action and delta streams must round-trip exactly at every
+// length around the SIMD and block boundaries, and truncated or corrupt input
+// must be rejected
+#include "column_codec.hpp"
+#include "test_support.hpp"
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+const size_t kLengths[] = {0, 1, 15, 16, 17, 63, 64, 65, 127, 128, 129, 1000};
+
+bool round_trip_actions(const std::vector<uint8_t>& actions) {
+    std::vector<uint8_t> encoded;
+    encode_actions(actions.data(), actions.size(), encoded);
+    std::vector<uint8_t> decoded(actions.size(), 0xFF);
+    return decode_actions(encoded.data(), encoded.size(), actions.size(), decoded.data()) &&
+           decoded == actions;
+}
+
+bool round_trip_deltas(const std::vector<int64_t>& values) {
+    std::vector<uint8_t> encoded;
+    encode_deltas(values.data(), values.size(), encoded);
+    std::vector<int64_t> decoded(values.size(), -1);
+    return decode_deltas(encoded.data(), encoded.size(), values.size(), decoded.data()) &&
+           decoded == values;
+}
+
+void test_action_lengths() {
+    std::mt19937 rng(5);
+    bool ok = true;
+    for (size_t n : kLengths) {
+        std::vector<uint8_t> actions(n);
+        for (auto& a : actions) a = static_cast<uint8_t>(rng() % 3);
+        ok = ok && round_trip_actions(actions);
+    }
+    check(ok, "random actions round-trip at boundary lengths");
+}
+
+void test_action_runs() {
+    // Long runs of every action, runs just below kActionMinRun and literals between
+    std::vector<uint8_t> actions;
+    actions.insert(actions.end(), 100000, 1);
+    actions.insert(actions.end(), kActionMinRun - 1, 2);
+    actions.insert(actions.end(), 70000, 0);
+    for (size_t i = 0; i < 50; ++i) actions.push_back(static_cast<uint8_t>(i % 3));
+    actions.insert(actions.end(), kActionMinRun, 2);
+    check(round_trip_actions(actions), "long runs round-trip");
+
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> run(1 << 20, 2);
+    encode_actions(run.data(), run.size(), encoded);
+    check(encoded.size() < 8, "a single long run encodes to a tag and a count");
+}
+
+void test_action_rejects_bad_input() {
+    std::vector<uint8_t> actions(200);
+    for (size_t i = 0; i < actions.size(); ++i) actions[i] = static_cast<uint8_t>(i % 3);
+    std::vector<uint8_t> encoded;
+    encode_actions(actions.data(), actions.size(), encoded);
+    std::vector<uint8_t> decoded(actions.size());
+
+    bool all_rejected = true;
+    for (size_t cut = 0; cut < encoded.size(); ++cut) {
+        all_rejected = all_rejected && !decode_actions(encoded.data(), cut, actions.size(), decoded.data());
+    }
+    check(all_rejected, "truncated action stream is rejected");
+
+    std::vector<uint8_t> bad_action = {0x00, 0x04, 0xFF};  // literal of four 3s
+    check(!decode_actions(bad_action.data(), bad_action.size(), 4, decoded.data()), "action 3 is rejected");
+    std::vector<uint8_t> bad_tag = {0x80, 0x04};
+    check(!decode_actions(bad_tag.data(), bad_tag.size(), 4, decoded.data()), "unknown tag is rejected");
+    std::vector<uint8_t> overlong = {0x41, 0x05};
+    check(!decode_actions(overlong.data(), overlong.size(), 4, decoded.data()), "run past count is rejected");
+}
+
+void test_delta_lengths() {
+    std::mt19937_64 rng(9);
+    bool ok = true;
+    for (size_t n : kLengths) {
+        std::vector<int64_t> values(n);
+        int64_t price = 69542;
+        for (auto& v : values) {
+            price += static_cast<int64_t>(rng() % 41) - 20;
+            v = price;
+        }
+        ok = ok && round_trip_deltas(values);
+    }
+    check(ok, "small deltas round-trip at boundary lengths");
+}
+
+void test_delta_extremes() {
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    // Alternating extremes give the largest wrapping deltas in both directions
+    std::vector<int64_t> values;
+    for (size_t i = 0; i < 300; ++i) values.push_back(i % 2 == 0 ? lo : hi);
+    check(round_trip_deltas(values), "INT64_MIN/INT64_MAX deltas round-trip");
+
+    std::vector<int64_t> mixed = {0, hi, lo, -1, 1, lo, lo, hi, 0};
+    check(round_trip_deltas(mixed), "mixed extreme deltas round-trip");
+
+    std::mt19937_64 rng(13);
+    std::vector<int64_t> random(1000);
+    for (auto& v : random) v = static_cast<int64_t>(rng());
+    check(round_trip_deltas(random), "full-width random values round-trip");
+}
+
+void test_delta_rejects_bad_input() {
+    std::vector<int64_t> values(300);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int64_t>(i * i);
+    std::vector<uint8_t> encoded;
+    encode_deltas(values.data(), values.size(), encoded);
+    std::vector<int64_t> decoded(values.size());
+
+    bool all_rejected = true;
+    for (size_t cut = 0; cut < encoded.size(); ++cut) {
+        all_rejected = all_rejected && !decode_deltas(encoded.data(), cut, values.size(), decoded.data());
+    }
+    check(all_rejected, "truncated delta stream is rejected");
+
+    std::vector<uint8_t> bad_width = encoded;
+    bad_width[8] = 65;
+    check(!decode_deltas(bad_width.data(), bad_width.size(), values.size(), decoded.data()),
+          "bit width over 64 is rejected");
+}
+
+} // namespace
+
+int main() {
+    test_action_lengths();
+    test_action_runs();
+    test_action_rejects_bad_input();
+    test_delta_lengths();
+    test_delta_extremes();
+    test_delta_rejects_bad_input();
+
+    return test_result("column codec");
+}
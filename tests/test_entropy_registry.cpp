@@ -0,0 +1,85 @@
+// Entropy registry: per-symbol entropy must match a SlidingEntropyCalculator
+// fed the same stream, and memory_usage_bytes() must stay within
+// max_memory_bytes() however the registry is filled
+#include "entropy_registry.hpp"
+#include "sliding_entropy_calculator.hpp"
+#include "test_support.hpp"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Sparse ids spread over the whole u32 range
+uint32_t sparse_id(uint32_t i) {
+    return i * 2654435761u + 12345u;
+}
+
+using FixedSlidingCalculator = BasicSlidingEntropyCalculator<ShannonEntropy, kTraderActionCount, FixedWindowPolicy>;
+
+// Interleaved streams for several symbols; each symbol's entropy and counts
+// must track a fixed-window sliding calculator fed only its actions,
+// before the window fills, across window laps and after many evictions
+void test_matches_sliding_calculator() {
+    const size_t window = 100;
+    const uint32_t symbols = 8;
+    EntropyRegistry registry(window, symbols);
+    std::vector<std::unique_ptr<FixedSlidingCalculator>> reference;
+    for (uint32_t s = 0; s < symbols; ++s) {
+        reference.push_back(std::make_unique<FixedSlidingCalculator>(window));
+    }
+
+    std::mt19937 rng(3);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < 20000; ++i) {
+        uint32_t s = rng() % symbols;
+        // Skewed per symbol so the distributions and entropies differ
+        auto action = static_cast<TraderAction>(rng() % (s % 3 + 1));
+        registry.add_action(sparse_id(s), action);
+        reference[s]->add_action(action);
+
+        double expected = reference[s]->get_current_entropy();
+        if (std::abs(registry.get_entropy(sparse_id(s)) - expected) > 1e-9) mismatches++;
+        if (registry.get_action_distribution(sparse_id(s)) != reference[s]->get_action_distribution()) mismatches++;
+    }
+    check(mismatches == 0, "registry entropy and counts match SlidingEntropyCalculator");
+
+    std::vector<TraderAction> batch(250, TraderAction::BUY);
+    for (size_t i = 0; i < batch.size(); i += 3) batch[i] = TraderAction::SELL;
+    registry.add_actions_batch(sparse_id(0), batch);
+    for (TraderAction action : batch) reference[0]->add_action(action);
+    check(std::abs(registry.get_entropy(sparse_id(0)) - reference[0]->get_current_entropy()) < 1e-9,
+          "add_actions_batch matches SlidingEntropyCalculator");
+}
+
+void test_memory_bound_when_full() {
+    EntropyRegistry registry(100, 100);
+    for (uint32_t i = 0; i < 100; ++i) {
+        check(registry.add_action(sparse_id(i), TraderAction::BUY), "add_action succeeds below max_symbols");
+        check(registry.memory_usage_bytes() <= registry.max_memory_bytes(), "usage within bound while filling");
+    }
+    check(!registry.add_action(sparse_id(100), TraderAction::BUY), "add_action fails once full");
+    check(registry.symbol_count() == 100, "registry holds max_symbols symbols");
+    check(registry.memory_usage_bytes() <= registry.max_memory_bytes(), "usage within bound when full");
+}
+
+void test_memory_bound_after_reserve() {
+    EntropyRegistry registry(64, 1000);
+    registry.reserve(5000);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        registry.add_action(sparse_id(i), TraderAction::SELL);
+    }
+    check(registry.symbol_count() == 1000, "reserved registry fills to max_symbols");
+    check(registry.memory_usage_bytes() <= registry.max_memory_bytes(), "usage within bound after reserve");
+}
+
+} // namespace
+
+int main() {
+    test_matches_sliding_calculator();
+    test_memory_bound_when_full();
+    test_memory_bound_after_reserve();
+
+    return test_result("entropy registry");
+}
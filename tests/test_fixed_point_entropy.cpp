@@ -0,0 +1,94 @@
+// Fixed-point entropy: |H_fixed - H_double| must stay within the documented
+// 2^-16 bits for random histograms of every size up to kFixedMaxTotal
+#include "fixed_point_entropy.hpp"
+#include "entropy_measures.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr double kErrorBound = 1.0 / (1 << kFixedEntropyFractionBits);
+
+// Random counts summing to total, skewed by a random power so both flat and
+// peaked histograms occur
+template <size_t N>
+std::array<uint32_t, N> random_counts(std::mt19937_64& rng, uint32_t total) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double skew = 1.0 + 8.0 * unit(rng);
+    std::array<double, N> weights{};
+    double sum = 0.0;
+    for (auto& w : weights) {
+        w = std::pow(unit(rng), skew);
+        sum += w;
+    }
+
+    std::array<uint32_t, N> counts{};
+    uint32_t assigned = 0;
+    for (size_t i = 0; i < N; ++i) {
+        counts[i] = static_cast<uint32_t>(weights[i] / sum * total);
+        assigned += counts[i];
+    }
+    counts[rng() % N] += total - assigned;
+    return counts;
+}
+
+template <size_t N>
+double max_error(std::mt19937_64& rng, size_t trials, uint32_t max_total) {
+    double worst = 0.0;
+    for (size_t t = 0; t < trials; ++t) {
+        // Log-uniform totals so small windows and interpolated ones both appear
+        uint32_t total = static_cast<uint32_t>(std::exp2(std::uniform_real_distribution<double>(
+            0.0, std::log2(static_cast<double>(max_total)))(rng)));
+        total = std::max<uint32_t>(total, 1);
+        std::array<uint32_t, N> counts = random_counts<N>(rng, total);
+
+        double fixed = evaluate_entropy<FixedPointShannonEntropy>(counts, total);
+        double exact = evaluate_entropy<ShannonEntropy>(counts, total);
+        worst = std::max(worst, std::abs(fixed - exact));
+    }
+    return worst;
+}
+
+void test_error_bound_three_states() {
+    std::mt19937_64 rng(101);
+    check(max_error<3>(rng, 200000, kFixedMaxTotal) <= kErrorBound, "3-state error within 2^-16");
+}
+
+void test_error_bound_small_windows() {
+    // Every total in the exact table range
+    std::mt19937_64 rng(202);
+    check(max_error<3>(rng, 100000, kFixedLog2TableSize - 1) <= kErrorBound, "table-range error within 2^-16");
+}
+
+void test_error_bound_large_alphabets() {
+    std::mt19937_64 rng(303);
+    check(max_error<16>(rng, 50000, kFixedMaxTotal) <= kErrorBound, "16-state error within 2^-16");
+    check(max_error<256>(rng, 5000, kFixedMaxTotal) <= kErrorBound, "256-state error within 2^-16");
+}
+
+void test_exact_cases() {
+    std::array<uint32_t, 3> single = {0, 500, 0};
+    check(fixed_point_entropy_q16(single, 500) == 0, "one populated bin is exactly 0");
+
+    std::array<uint32_t, 4> uniform = {1 << 20, 1 << 20, 1 << 20, 1 << 20};
+    check(fixed_point_entropy_q16(uniform, 1 << 22) == 2u << kFixedEntropyFractionBits,
+          "uniform over 4 bins is exactly 2 bits");
+
+    std::array<uint32_t, 3> counts = {123, 4567, 8901};
+    check(evaluate_entropy<FixedPointShannonEntropy>(counts, 13591) ==
+              fixed_q16_to_double(fixed_point_entropy_q16(counts, 13591)),
+          "finalize is the Q16.16 value");
+}
+
+} // namespace
+
+int main() {
+    test_error_bound_three_states();
+    test_error_bound_small_windows();
+    test_error_bound_large_alphabets();
+    test_exact_cases();
+
+    return test_result("fixed point entropy");
+}
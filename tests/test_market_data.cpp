@@ -0,0 +1,64 @@
+// MarketData moves: a moved-from event, inline or spilled, must be empty and
+// reusable like a freshly constructed one
+#include "market_data.hpp"
+#include "test_support.hpp"
+#include <memory_resource>
+#include <utility>
+
+namespace {
+
+MarketData spilled_event(size_t n) {
+    MarketData data;
+    for (size_t i = 0; i < n; ++i) data.add_action(static_cast<TraderAction>(i % 3));
+    return data;
+}
+
+// Refills a moved-from event and checks it holds exactly the new actions
+void check_reusable(MarketData& data, const char* what) {
+    check(data.empty() && data.size() == 0, what);
+    for (size_t i = 0; i < 20; ++i) data.add_action(TraderAction::SELL);
+    bool all_sell = data.size() == 20;
+    data.for_each_action([&all_sell](TraderAction a) { all_sell = all_sell && a == TraderAction::SELL; });
+    check(all_sell, "moved-from event refills with only the new actions");
+}
+
+void test_move_construct_spilled() {
+    MarketData a = spilled_event(20);
+    MarketData b(std::move(a));
+    check(b.size() == 20 && b.action_at(19) == TraderAction::BUY, "move construction keeps the actions");
+    check_reusable(a, "move-constructed-from spilled event is empty");
+}
+
+void test_move_assign_spilled() {
+    MarketData a = spilled_event(20);
+    MarketData b = spilled_event(3);
+    b = std::move(a);
+    check(b.size() == 20 && b.action_at(19) == TraderAction::BUY, "move assignment keeps the actions");
+    check_reusable(a, "move-assigned-from spilled event is empty");
+}
+
+void test_move_inline() {
+    MarketData a = spilled_event(5);
+    MarketData b(std::move(a));
+    check(b.size() == 5 && b.action_at(4) == TraderAction::BUY, "inline move keeps the actions");
+    check_reusable(a, "moved-from inline event is empty");
+}
+
+void test_move_across_resources() {
+    std::pmr::monotonic_buffer_resource arena;
+    MarketData a = spilled_event(20);
+    MarketData b(std::move(a), MarketData::allocator_type(&arena));
+    check(b.size() == 20 && b.get_allocator().resource() == &arena, "allocator-extended move uses the new resource");
+    check_reusable(a, "allocator-extended moved-from event is empty");
+}
+
+} // namespace
+
+int main() {
+    test_move_construct_spilled();
+    test_move_assign_spilled();
+    test_move_inline();
+    test_move_across_resources();
+
+    return test_result("market data");
+}
@@ -0,0 +1,58 @@
+// Quantile discretizer edge cases: crossing P-square estimates must never
+// produce an action outside HOLD/BUY/SELL
+#include "quantile_discretizer.hpp"
+#include "test_support.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+// Returns drawn from a handful of values, so both estimators sit on ties and
+// their independent estimates cross
+std::vector<double> tie_heavy_returns(size_t n, uint32_t seed) {
+    const double levels[] = {-0.1, 0.0, 0.0, 0.0, 0.0, 0.1};
+    std::mt19937 rng(seed);
+    std::vector<double> returns(n);
+    for (auto& r : returns) r = levels[rng() % 6];
+    return returns;
+}
+
+void test_crossing_estimates_single() {
+    QuantileDiscretizer discretizer(0.45, 0.55, 50, 5);
+    size_t invalid = 0;
+    size_t crossed = 0;
+    for (double r : tie_heavy_returns(200000, 7)) {
+        double lower;
+        double upper;
+        discretizer.get_cutoffs(lower, upper);
+        if (lower > upper) crossed++;
+        if (static_cast<uint8_t>(discretizer.discretize(r)) >= kTraderActionCount) invalid++;
+    }
+    check(crossed == 0, "get_cutoffs returns lower <= upper");
+    check(invalid == 0, "discretize emits only HOLD/BUY/SELL");
+}
+
+void test_crossing_estimates_batch() {
+    QuantileDiscretizer discretizer(0.45, 0.55, 50, 5);
+    std::vector<double> returns = tie_heavy_returns(200000, 11);
+    std::vector<TraderAction> actions(returns.size());
+    for (size_t i = 0; i < returns.size(); i += 64) {
+        size_t n = std::min<size_t>(64, returns.size() - i);
+        discretizer.discretize_batch(returns.data() + i, n, actions.data() + i);
+    }
+
+    size_t invalid = 0;
+    for (TraderAction action : actions) {
+        if (static_cast<uint8_t>(action) >= kTraderActionCount) invalid++;
+    }
+    check(invalid == 0, "discretize_batch emits only HOLD/BUY/SELL");
+}
+
+} // namespace
+
+int main() {
+    test_crossing_estimates_single();
+    test_crossing_estimates_batch();
+
+    return test_result("quantile discretizer");
+}
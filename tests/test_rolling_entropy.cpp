@@ -0,0 +1,78 @@
+// Rolling entropy: the offline series must be bit-identical to a fixed-window
+// sliding calculator fed the same actions, serially and on the thread pool
+#include "rolling_entropy.hpp"
+#include "sliding_entropy_calculator.hpp"
+#include "test_support.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+// Regimes of different skew so the window sees rising and falling entropy
+template <size_t States>
+std::vector<typename ActionAlphabet<States>::symbol_type> regime_actions(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<typename ActionAlphabet<States>::symbol_type> actions(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t spread = 1 + (i / 5000) % States;
+        actions[i] = static_cast<typename ActionAlphabet<States>::symbol_type>(rng() % spread);
+    }
+    return actions;
+}
+
+template <typename Measure, size_t States>
+size_t streaming_mismatches(const std::vector<typename ActionAlphabet<States>::symbol_type>& actions,
+                            size_t window, const std::vector<double>& series) {
+    BasicSlidingEntropyCalculator<Measure, States, FixedWindowPolicy> calculator(window);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        calculator.add_action(actions[i]);
+        if (series[i] != calculator.get_current_entropy()) mismatches++;
+    }
+    return mismatches;
+}
+
+template <typename Measure, size_t States>
+void check_matches_streaming(size_t window, const char* serial_what, const char* pool_what) {
+    auto actions = regime_actions<States>(100000, 17);
+
+    std::vector<double> serial = rolling_entropy<Measure, States>(actions, window);
+    check(streaming_mismatches<Measure, States>(actions, window, serial) == 0, serial_what);
+
+    // Small chunks so many chunk boundaries re-prime their window
+    ThreadPool pool(4);
+    std::vector<double> parallel(actions.size());
+    rolling_entropy<Measure, States>(actions.data(), actions.size(), window, parallel.data(), pool, 4 * window);
+    check(parallel == serial, pool_what);
+}
+
+void test_shannon() {
+    check_matches_streaming<ShannonEntropy, kTraderActionCount>(
+        100, "Shannon series matches the sliding calculator", "Shannon series on the pool matches serial");
+}
+
+void test_collision() {
+    check_matches_streaming<CollisionEntropy, kTraderActionCount>(
+        250, "collision series matches the sliding calculator", "collision series on the pool matches serial");
+}
+
+void test_larger_alphabet() {
+    check_matches_streaming<ShannonEntropy, 5>(
+        64, "5-state series matches the sliding calculator", "5-state series on the pool matches serial");
+}
+
+void test_window_of_one() {
+    check_matches_streaming<ShannonEntropy, kTraderActionCount>(
+        1, "window 1 series matches the sliding calculator", "window 1 series on the pool matches serial");
+}
+
+} // namespace
+
+int main() {
+    test_shannon();
+    test_collision();
+    test_larger_alphabet();
+    test_window_of_one();
+
+    return test_result("rolling entropy");
+}
@@ -0,0 +1,22 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+#include <iostream>
+
+// Shared by the test executables: check() records a failure and keeps going,
+// test_result() reports the suite and gives main() its exit code.
+inline int test_failures = 0;
+
+inline void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        test_failures++;
+    }
+}
+
+inline int test_result(const char* suite) {
+    if (test_failures == 0) std::cout << "All " << suite << " tests passed" << std::endl;
+    return test_failures == 0 ? 0 : 1;
+}
+
+#endif // TEST_SUPPORT_HPP
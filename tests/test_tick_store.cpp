@@ -0,0 +1,164 @@
+// Tick store: write -> mmap -> read must return every row unchanged for both
+// the raw and the compressed layout, lower_bound must agree with a plain
+// binary search at and beyond the range edges, and corrupted metadata must be
+// rejected at open()
+#include "tick_store.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Timestamps with long runs of duplicates so equal values straddle index strides
+std::vector<MarketEvent> make_events(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<MarketEvent> events(n);
+    uint64_t ts = 1000;
+    for (size_t i = 0; i < n; ++i) {
+        if (rng() % 4 == 0) ts += 1 + rng() % 50;
+        events[i] = make_market_event(ts, rng() % 100, 600.0 + (rng() % 20000) * kPriceTickSize,
+                                      rng() % 1000, static_cast<TraderAction>(rng() % 3), kEventTrade);
+    }
+    return events;
+}
+
+std::string store_directory(const char* name) {
+    return (std::filesystem::temp_directory_path() / ("queue_tick_store_test_" + std::string(name))).string();
+}
+
+bool write_store(const std::string& directory, const std::vector<MarketEvent>& events,
+                 TickStoreCompression compression) {
+    // Small stride and buffer so the store has many index entries and chunks
+    TickStoreWriter writer(64, 1000, compression);
+    return writer.open(directory) && writer.append(events.data(), events.size()) && writer.close();
+}
+
+bool same_event(const MarketEvent& a, const MarketEvent& b) {
+    return a.timestamp_ns == b.timestamp_ns && a.price_ticks == b.price_ticks && a.size == b.size &&
+           a.symbol_id == b.symbol_id && a.action == b.action;
+}
+
+void check_round_trip(TickStoreCompression compression, const char* name) {
+    std::vector<MarketEvent> events = make_events(5000, 21);
+    std::string directory = store_directory(name);
+    check(write_store(directory, events, compression), "store writes");
+
+    TickStoreReader reader;
+    check(reader.open(directory), "store opens");
+    check(reader.rows() == events.size() && reader.compression() == compression, "row count and layout");
+
+    std::vector<MarketEvent> read(events.size());
+    check(reader.read_events(0, read.size() + 10, read.data()) == events.size(), "read_events stops at rows()");
+    bool same = true;
+    for (size_t i = 0; i < events.size(); ++i) same = same && same_event(read[i], events[i]);
+    check(same, "every row reads back unchanged");
+
+    MarketDataView view = reader.action_view(100, 200);
+    bool actions_match = view.size() == 100;
+    for (size_t i = 0; actions_match && i < view.size(); ++i) {
+        actions_match = view.action_at(i) == events[100 + i].action;
+    }
+    check(actions_match, "action_view covers the requested rows");
+
+    // Every distinct timestamp, the gaps between them and both ends
+    std::vector<uint64_t> timestamps(events.size());
+    for (size_t i = 0; i < events.size(); ++i) timestamps[i] = events[i].timestamp_ns;
+    std::vector<uint64_t> queries = {0, timestamps.front() - 1, timestamps.back() + 1, UINT64_MAX};
+    for (uint64_t ts : timestamps) {
+        queries.push_back(ts);
+        queries.push_back(ts + 1);
+    }
+    size_t wrong = 0;
+    for (uint64_t ts : queries) {
+        uint64_t expected = static_cast<uint64_t>(
+            std::lower_bound(timestamps.begin(), timestamps.end(), ts) - timestamps.begin());
+        if (reader.lower_bound(ts) != expected) wrong++;
+    }
+    check(wrong == 0, "lower_bound matches std::lower_bound");
+    check(reader.lower_bound(0) == 0, "lower_bound before the first row is 0");
+    check(reader.lower_bound(UINT64_MAX) == reader.rows(), "lower_bound past the last row is rows()");
+
+    reader.close();
+    std::filesystem::remove_all(directory);
+}
+
+void test_raw_round_trip() {
+    check_round_trip(TickStoreCompression::NONE, "raw");
+}
+
+void test_compressed_round_trip() {
+    check_round_trip(TickStoreCompression::COLUMN_CODEC, "compressed");
+}
+
+void test_empty_store() {
+    std::string directory = store_directory("empty");
+    check(write_store(directory, {}, TickStoreCompression::NONE), "empty store writes");
+    TickStoreReader reader;
+    check(reader.open(directory) && reader.rows() == 0, "empty store opens with no rows");
+    check(reader.lower_bound(12345) == 0, "lower_bound on an empty store is 0");
+    reader.close();
+    std::filesystem::remove_all(directory);
+}
+
+// Overwrites len bytes of meta.bin at offset
+void patch_meta(const std::string& directory, long offset, const void* bytes, size_t len) {
+    std::FILE* file = std::fopen((directory + "/meta.bin").c_str(), "r+b");
+    std::fseek(file, offset, SEEK_SET);
+    std::fwrite(bytes, 1, len, file);
+    std::fclose(file);
+}
+
+void test_corrupted_header() {
+    std::vector<MarketEvent> events = make_events(500, 4);
+    std::string directory = store_directory("corrupt");
+    TickStoreReader reader;
+
+    const uint32_t bad_magic = 0xDEADBEEF;
+    const uint32_t bad_version = kTickStoreVersion + 1;
+    const uint64_t bad_rows = events.size() + 1;
+    const uint32_t zero_stride = 0;
+    const uint32_t bad_flags = 7;
+    struct Patch { long offset; const void* bytes; size_t len; const char* what; };
+    const Patch patches[] = {
+        {0, &bad_magic, sizeof(bad_magic), "bad magic is rejected"},
+        {4, &bad_version, sizeof(bad_version), "newer version is rejected"},
+        {8, &bad_rows, sizeof(bad_rows), "row count that disagrees with the columns is rejected"},
+        {16, &zero_stride, sizeof(zero_stride), "zero index stride is rejected"},
+        {24, &bad_flags, sizeof(bad_flags), "unknown compression flag is rejected"},
+    };
+    for (const Patch& patch : patches) {
+        write_store(directory, events, TickStoreCompression::NONE);
+        patch_meta(directory, patch.offset, patch.bytes, patch.len);
+        check(!reader.open(directory) && !reader.is_open(), patch.what);
+    }
+
+    write_store(directory, events, TickStoreCompression::NONE);
+    std::filesystem::resize_file(directory + "/meta.bin", 16);
+    check(!reader.open(directory), "truncated meta.bin is rejected");
+
+    write_store(directory, events, TickStoreCompression::NONE);
+    const uint8_t bad_action = 3;
+    std::FILE* file = std::fopen((directory + "/action.col").c_str(), "r+b");
+    std::fseek(file, 17, SEEK_SET);
+    std::fwrite(&bad_action, 1, 1, file);
+    std::fclose(file);
+    check(!reader.open(directory), "invalid raw action byte is rejected");
+
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace
+
+int main() {
+    test_raw_round_trip();
+    test_compressed_round_trip();
+    test_empty_store();
+    test_corrupted_header();
+
+    return test_result("tick store");
+}
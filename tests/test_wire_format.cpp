@@ -0,0 +1,161 @@
+// Wire format: WireReader must walk mixed ACTIONS/EVENTS buffers in place,
+// skip unknown kinds, and report each kind of damage with its WireStatus
+#include "wire_format.hpp"
+#include "test_support.hpp"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const TraderAction kActions[] = {TraderAction::BUY, TraderAction::HOLD, TraderAction::SELL,
+                                 TraderAction::SELL, TraderAction::BUY};
+
+std::vector<MarketEvent> sample_events() {
+    return {make_market_event(100, 7, 695.42, 10, TraderAction::BUY, kEventTrade),
+            make_market_event(200, 8, 695.40, 20, TraderAction::SELL, kEventQuote),
+            make_market_event(300, 7, 695.45, 30, TraderAction::HOLD, kEventTrade)};
+}
+
+// ACTIONS, EVENTS, ACTIONS from a MarketData
+std::vector<uint8_t> mixed_buffer() {
+    std::vector<uint8_t> buffer;
+    append_wire_actions(buffer, 3, kActions, 5);
+    std::vector<MarketEvent> events = sample_events();
+    append_wire_events(buffer, 9, events.data(), events.size());
+    MarketData data;
+    for (int i = 0; i < 20; ++i) data.add_action(static_cast<TraderAction>(i % 3));
+    append_wire_actions(buffer, 4, data);
+    return buffer;
+}
+
+WireStatus first_status(const std::vector<uint8_t>& buffer) {
+    WireReader reader(buffer.data(), buffer.size());
+    WireFrame frame;
+    WireStatus status;
+    while ((status = reader.next(frame)) == WireStatus::OK) {}
+    return status;
+}
+
+void test_mixed_frames() {
+    std::vector<uint8_t> buffer = mixed_buffer();
+    check(buffer.size() % 8 == 0, "frames are padded to 8 bytes");
+
+    WireReader reader(buffer.data(), buffer.size());
+    WireFrame frame;
+
+    check(reader.next(frame) == WireStatus::OK && frame.kind == WireFrameKind::ACTIONS, "first frame is ACTIONS");
+    bool actions_match = frame.symbol_id == 3 && frame.actions.size() == 5 &&
+                         frame.actions.data() == buffer.data() + kWireHeaderSize;
+    for (size_t i = 0; actions_match && i < 5; ++i) actions_match = frame.actions.action_at(i) == kActions[i];
+    check(actions_match, "ACTIONS frame views the buffer's action bytes");
+
+    check(reader.next(frame) == WireStatus::OK && frame.kind == WireFrameKind::EVENTS, "second frame is EVENTS");
+    std::vector<MarketEvent> events = sample_events();
+    bool events_match = frame.symbol_id == 9 && frame.events.size() == events.size();
+    for (size_t i = 0; events_match && i < events.size(); ++i) {
+        MarketEvent e = frame.events.event_at(i);
+        events_match = std::memcmp(&e, &events[i], sizeof(MarketEvent)) == 0 &&
+                       frame.events.action_at(i) == events[i].action;
+    }
+    check(events_match, "EVENTS frame decodes every record");
+
+    check(reader.next(frame) == WireStatus::OK && frame.actions.size() == 20 && frame.symbol_id == 4,
+          "third frame is the spilled MarketData");
+    check(reader.next(frame) == WireStatus::END && reader.next(frame) == WireStatus::END, "END after the last frame");
+}
+
+void test_unknown_kind_is_skipped() {
+    std::vector<uint8_t> buffer;
+    append_wire_actions(buffer, 1, kActions, 5);
+    buffer[5] = 0x7F;  // unknown kind, payload length still valid
+    append_wire_actions(buffer, 2, kActions, 3);
+
+    WireReader reader(buffer.data(), buffer.size());
+    WireFrame frame;
+    check(reader.next(frame) == WireStatus::OK && frame.symbol_id == 2, "unknown kind is skipped by payload length");
+    check(reader.next(frame) == WireStatus::END, "END after skipping");
+}
+
+void test_truncated() {
+    std::vector<uint8_t> buffer = mixed_buffer();
+    bool all_truncated = true;
+    // Every cut inside the first frame's header or payload
+    size_t first_frame = kWireHeaderSize + wire_detail::padded(5);
+    for (size_t cut = 1; cut < first_frame; ++cut) {
+        all_truncated = all_truncated &&
+                        first_status(std::vector<uint8_t>(buffer.begin(), buffer.begin() + cut)) == WireStatus::TRUNCATED;
+    }
+    check(all_truncated, "cut inside a frame is TRUNCATED");
+    check(first_status(std::vector<uint8_t>(buffer.begin(), buffer.end() - 8)) == WireStatus::TRUNCATED,
+          "cut in the last frame is TRUNCATED");
+}
+
+void test_bad_header() {
+    std::vector<uint8_t> buffer = mixed_buffer();
+
+    std::vector<uint8_t> bad_magic = buffer;
+    bad_magic[0] ^= 0xFF;
+    check(first_status(bad_magic) == WireStatus::BAD_MAGIC, "corrupt magic is BAD_MAGIC");
+
+    std::vector<uint8_t> bad_version = buffer;
+    bad_version[4] = kWireVersion + 1;
+    check(first_status(bad_version) == WireStatus::UNSUPPORTED_VERSION, "newer version is UNSUPPORTED_VERSION");
+    bad_version[4] = 0;
+    check(first_status(bad_version) == WireStatus::UNSUPPORTED_VERSION, "version 0 is UNSUPPORTED_VERSION");
+
+    std::vector<uint8_t> unaligned = buffer;
+    wire_detail::store_u32(unaligned.data() + 16, 5);
+    check(first_status(unaligned) == WireStatus::BAD_LENGTH, "unaligned payload length is BAD_LENGTH");
+
+    std::vector<uint8_t> short_payload = buffer;
+    wire_detail::store_u32(short_payload.data() + 12, 9);  // 9 actions in an 8-byte payload
+    check(first_status(short_payload) == WireStatus::BAD_LENGTH, "count past the payload is BAD_LENGTH");
+
+    std::vector<uint8_t> past_end = buffer;
+    wire_detail::store_u32(past_end.data() + 16, 1 << 20);
+    check(first_status(past_end) == WireStatus::TRUNCATED, "payload length past the buffer is TRUNCATED");
+}
+
+void test_invalid_actions() {
+    std::vector<uint8_t> actions;
+    append_wire_actions(actions, 1, kActions, 5);
+    actions[kWireHeaderSize + 2] = 3;
+    check(first_status(actions) == WireStatus::INVALID_ACTION, "bad byte in ACTIONS is INVALID_ACTION");
+
+    std::vector<uint8_t> events;
+    std::vector<MarketEvent> records = sample_events();
+    append_wire_events(events, 1, records.data(), records.size());
+    events[kWireHeaderSize + 2 * kWireEventSize + offsetof(MarketEvent, action)] = 0xFF;
+    check(first_status(events) == WireStatus::INVALID_ACTION, "bad action in EVENTS is INVALID_ACTION");
+
+    // Padding after count is not an action and is never checked
+    std::vector<uint8_t> padding;
+    append_wire_actions(padding, 1, kActions, 5);
+    padding[kWireHeaderSize + 6] = 0xFF;
+    check(first_status(padding) == WireStatus::END, "padding bytes are ignored");
+}
+
+void test_reader_stops_after_error() {
+    std::vector<uint8_t> buffer;
+    append_wire_actions(buffer, 1, kActions, 5);
+    buffer[0] = 0;
+    append_wire_actions(buffer, 2, kActions, 5);
+
+    WireReader reader(buffer.data(), buffer.size());
+    WireFrame frame;
+    check(reader.next(frame) == WireStatus::BAD_MAGIC, "first frame fails");
+    check(reader.next(frame) == WireStatus::END && reader.offset() == buffer.size(), "reader stops at the first error");
+}
+
+} // namespace
+
+int main() {
+    test_mixed_frames();
+    test_unknown_kind_is_skipped();
+    test_truncated();
+    test_bad_header();
+    test_invalid_actions();
+    test_reader_stops_after_error();
+
+    return test_result("wire format");
+}